@@ -0,0 +1,98 @@
+#ifndef ARCHIVOMAPEADO_H
+#define ARCHIVOMAPEADO_H
+
+#include <string>
+#include <string_view>
+#include <cstddef>
+
+#if defined(_WIN32)
+    #ifndef NOMINMAX
+    #define NOMINMAX
+    #endif
+    #include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+// ArchivoMapeado - Mapea un archivo completo en memoria de solo lectura (RAII)
+// El contenido se expone como std::string_view sin copiar datos al heap:
+// el sistema operativo carga las páginas bajo demanda.
+class ArchivoMapeado {
+private:
+    const char* datos = nullptr;
+    size_t tamano = 0;
+#if defined(_WIN32)
+    HANDLE archivo = INVALID_HANDLE_VALUE;
+    HANDLE mapeo = nullptr;
+#endif
+
+    // O(1) - Liberar el mapeo y los descriptores
+    void cerrar() {
+#if defined(_WIN32)
+        if (datos) UnmapViewOfFile(datos);
+        if (mapeo) CloseHandle(mapeo);
+        if (archivo != INVALID_HANDLE_VALUE) CloseHandle(archivo);
+        mapeo = nullptr;
+        archivo = INVALID_HANDLE_VALUE;
+#elif defined(__unix__) || defined(__APPLE__)
+        if (datos && tamano > 0) munmap(const_cast<char*>(datos), tamano);
+#endif
+        datos = nullptr;
+        tamano = 0;
+    }
+
+public:
+    // O(1) - Solo se reserva el rango de direcciones, no se lee el archivo
+    explicit ArchivoMapeado(const std::string& nombreArchivo) {
+#if defined(_WIN32)
+        archivo = CreateFileA(nombreArchivo.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                              nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (archivo == INVALID_HANDLE_VALUE) return;
+
+        LARGE_INTEGER tam;
+        if (!GetFileSizeEx(archivo, &tam) || tam.QuadPart == 0) { cerrar(); return; }
+
+        mapeo = CreateFileMappingA(archivo, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapeo) { cerrar(); return; }
+
+        datos = static_cast<const char*>(MapViewOfFile(mapeo, FILE_MAP_READ, 0, 0, 0));
+        if (!datos) { cerrar(); return; }
+        tamano = static_cast<size_t>(tam.QuadPart);
+#elif defined(__unix__) || defined(__APPLE__)
+        int fd = open(nombreArchivo.c_str(), O_RDONLY);
+        if (fd < 0) return;
+
+        struct stat info;
+        if (fstat(fd, &info) != 0 || info.st_size <= 0) { close(fd); return; }
+
+        void* p = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd); // El mapeo sigue vigente aunque se cierre el descriptor
+        if (p == MAP_FAILED) return;
+
+        // Lectura secuencial: el kernel puede adelantar páginas agresivamente
+        madvise(p, static_cast<size_t>(info.st_size), MADV_SEQUENTIAL);
+        datos = static_cast<const char*>(p);
+        tamano = static_cast<size_t>(info.st_size);
+#else
+        (void)nombreArchivo; // Sin soporte de mapeo: valido() devuelve false
+#endif
+    }
+
+    ~ArchivoMapeado() { cerrar(); }
+
+    ArchivoMapeado(const ArchivoMapeado&) = delete;
+    ArchivoMapeado& operator=(const ArchivoMapeado&) = delete;
+
+    // O(1) - El mapeo fue exitoso y el archivo no está vacío
+    bool valido() const { return datos != nullptr; }
+
+    // O(1) - Vista sobre la región mapeada (válida mientras viva el objeto)
+    std::string_view contenido() const { return std::string_view(datos, tamano); }
+
+    size_t size() const { return tamano; } // O(1)
+};
+
+#endif
@@ -0,0 +1,242 @@
+#ifndef BOSQUEJOCUANTILES_H
+#define BOSQUEJOCUANTILES_H
+
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <iterator>
+
+// BosquejoKLL - Bosquejo de cuantiles KLL (Karnin, Lang y Liberty) en memoria acotada
+// Los valores entran al nivel 0; cada nivel h guarda muestras que valen 2^h
+// lecturas. Cuando el bosquejo se llena, el primer nivel que excede su
+// capacidad se compacta: ya ordenado, la mitad de sus elementos (los pares o
+// los impares, al azar) sube al nivel siguiente con el doble de peso. Solo el
+// nivel 0 se ordena; los de arriba reciben corridas ordenadas y las mezclan. Las capacidades decrecen
+// en razón 2/3 desde el nivel más alto (k) hacia abajo (mínimo 8), así se
+// retienen a lo sumo ~3k valores más O(log(n / k)) niveles, sin importar n.
+// Error: el rango normalizado de un cuantil estimado se desvía a lo sumo
+// ~1.3 % con k = 200 (99 % de confianza) y el error baja como ~1/k. El mínimo
+// y el máximo son exactos. Dos bosquejos se combinan sumando sus niveles, con
+// la misma garantía que si uno solo hubiera visto todas las lecturas (p. ej.
+// percentiles de una flota o de varios bloques de tiempo).
+// El azar viene de un generador propio con semilla fija: los resultados son
+// reproducibles entre ejecuciones. El estado completo (niveles y generador) se
+// puede guardar y reponer (ver desdeNiveles), p. ej. en una instantánea.
+class BosquejoKLL {
+private:
+    static constexpr size_t CAPACIDAD_MINIMA = 8;
+
+    size_t k;
+    std::vector<std::vector<double>> niveles;
+    std::vector<size_t> capacidades; // capacidades[h], recalculadas al agregar un nivel
+    size_t capacidadTotal = 0;
+    size_t retenidos = 0;
+    uint64_t n = 0;
+    double minimo = 0.0;
+    double maximo = 0.0;
+    uint64_t estado = 0x9E3779B97F4A7C15ull; // xorshift64
+
+    // Muestras ordenadas por valor con su peso acumulado, para que varias consultas
+    // seguidas (p50, p95, p99...) ordenen una sola vez; se invalida al agregar
+    mutable std::vector<std::pair<double, uint64_t>> acumuladas;
+    mutable bool acumuladasValidas = false;
+
+    // O(H) - Agregar un nivel vacío arriba y recalcular las capacidades
+    void agregarNivel() {
+        niveles.emplace_back();
+        capacidades.resize(niveles.size());
+        capacidadTotal = 0;
+        for (size_t h = 0; h < niveles.size(); h++) {
+            double escala = std::pow(2.0 / 3.0, static_cast<double>(niveles.size() - 1 - h));
+            capacidades[h] = std::max(CAPACIDAD_MINIMA, static_cast<size_t>(std::ceil(static_cast<double>(k) * escala)));
+            capacidadTotal += capacidades[h];
+        }
+    }
+
+    // O(1) - Bit pseudoaleatorio
+    unsigned bitAleatorio() {
+        estado ^= estado << 13;
+        estado ^= estado >> 7;
+        estado ^= estado << 17;
+        return static_cast<unsigned>(estado >> 63);
+    }
+
+    // O(c log c) en el nivel 0, O(c) arriba - Compactar el primer nivel lleno (c = su tamaño)
+    // Si tiene un número impar de elementos, el menor se queda en el nivel
+    void compactar() {
+        size_t h = 0;
+        while (niveles[h].size() < capacidades[h]) h++;
+        if (h + 1 == niveles.size()) agregarNivel();
+        std::vector<double>& nivel = niveles[h];
+        std::vector<double>& arriba = niveles[h + 1];
+        if (h == 0) std::sort(nivel.begin(), nivel.end());
+        size_t queda = nivel.size() % 2;
+        size_t previos = arriba.size();
+        for (size_t i = queda + bitAleatorio(); i < nivel.size(); i += 2) arriba.push_back(nivel[i]);
+        std::inplace_merge(arriba.begin(), arriba.begin() + previos, arriba.end());
+        retenidos -= (nivel.size() - queda) / 2;
+        nivel.resize(queda);
+    }
+
+    // O(r log r) la primera vez tras agregar, O(1) después - Muestras retenidas
+    // ordenadas por valor con el peso acumulado hasta cada una (inclusive)
+    const std::vector<std::pair<double, uint64_t>>& muestrasAcumuladas() const {
+        if (acumuladasValidas) return acumuladas;
+        acumuladas.clear();
+        acumuladas.reserve(retenidos);
+        for (size_t h = 0; h < niveles.size(); h++) {
+            for (double v : niveles[h]) acumuladas.emplace_back(v, uint64_t(1) << h);
+        }
+        std::sort(acumuladas.begin(), acumuladas.end());
+        uint64_t acumulado = 0;
+        for (auto& muestra : acumuladas) muestra.second = acumulado += muestra.second;
+        acumuladasValidas = true;
+        return acumuladas;
+    }
+
+    // O(1) - Extremos exactos con la lectura nueva (el primero fija ambos)
+    void actualizarExtremos(double valor) {
+        if (n == 0) minimo = maximo = valor;
+        minimo = std::min(minimo, valor);
+        maximo = std::max(maximo, valor);
+    }
+
+public:
+    // O(1) - 'k' fija la precisión (y la memoria, ~3k valores)
+    explicit BosquejoKLL(size_t k = 200) : k(std::max(k, CAPACIDAD_MINIMA)) {
+        agregarNivel();
+    }
+
+    // O(1) amortizado (O(log k) con las compactaciones) - Incorporar un valor
+    void agregar(double valor) {
+        actualizarExtremos(valor);
+        n++;
+        niveles[0].push_back(valor);
+        acumuladasValidas = false;
+        if (++retenidos >= capacidadTotal) compactar();
+    }
+
+    // O(m) amortizado - Incorporar m valores contiguos: se copian al nivel 0 de a
+    // tramos que llenan justo la capacidad libre y se compacta una vez por tramo.
+    // Las compactaciones caen en los mismos puntos que agregando de a uno, así el
+    // bosquejo resultante es idéntico
+    void agregar(const double* valores, size_t m) {
+        if (m == 0) return;
+        acumuladasValidas = false;
+        while (m > 0) {
+            size_t tramo = std::min(m, capacidadTotal - retenidos);
+            for (size_t i = 0; i < tramo; i++) {
+                actualizarExtremos(valores[i]);
+                n++;
+            }
+            niveles[0].insert(niveles[0].end(), valores, valores + tramo);
+            retenidos += tramo;
+            if (retenidos >= capacidadTotal) compactar();
+            valores += tramo;
+            m -= tramo;
+        }
+    }
+
+    // O(r) - Combinar con otro bosquejo (se conserva el k propio)
+    void combinar(const BosquejoKLL& otro) {
+        if (otro.n == 0) return;
+        acumuladasValidas = false;
+        if (n == 0) { minimo = otro.minimo; maximo = otro.maximo; }
+        minimo = std::min(minimo, otro.minimo);
+        maximo = std::max(maximo, otro.maximo);
+        n += otro.n;
+        while (niveles.size() < otro.niveles.size()) agregarNivel();
+        for (size_t h = 0; h < otro.niveles.size(); h++) {
+            std::vector<double>& nivel = niveles[h];
+            size_t previos = nivel.size();
+            nivel.insert(nivel.end(), otro.niveles[h].begin(), otro.niveles[h].end());
+            if (h > 0) std::inplace_merge(nivel.begin(), nivel.begin() + previos, nivel.end());
+            retenidos += otro.niveles[h].size();
+        }
+        while (retenidos >= capacidadTotal) compactar();
+    }
+
+    // O(log r) (más O(r log r) si hubo lecturas desde la última consulta) - Valor
+    // aproximado del cuantil q (0..1): la menor muestra cuyo peso acumulado
+    // alcanza q·n. Con q <= 0 o q >= 1, el mínimo o el máximo exactos; 0.0 si está vacío
+    double cuantil(double q) const {
+        if (n == 0) return 0.0;
+        if (q <= 0.0) return minimo;
+        if (q >= 1.0) return maximo;
+        double objetivo = q * static_cast<double>(n);
+        const auto& muestras = muestrasAcumuladas();
+        auto muestra = std::partition_point(muestras.begin(), muestras.end(), [objetivo](const auto& m) {
+            return static_cast<double>(m.second) < objetivo;
+        });
+        return muestra == muestras.end() ? maximo : muestra->first;
+    }
+
+    // Igual que cuantil - Fracción aproximada de lecturas con valor estrictamente menor que 'valor'
+    double rango(double valor) const {
+        if (n == 0) return 0.0;
+        const auto& muestras = muestrasAcumuladas();
+        auto primera = std::partition_point(muestras.begin(), muestras.end(), [valor](const auto& m) {
+            return m.first < valor;
+        });
+        uint64_t menores = primera == muestras.begin() ? 0 : std::prev(primera)->second;
+        return static_cast<double>(menores) / static_cast<double>(n);
+    }
+
+    // O(H + r) - Tamaños de nivel y valores guardados que cumplen los
+    // invariantes del bosquejo: 1..64 niveles, menos retenidos que la capacidad
+    // total, los niveles de arriba ordenados y pesos (tamaño · 2^h) que suman n
+    static bool nivelesValidos(size_t k, uint64_t n, const uint64_t* tamanos, size_t numNiveles,
+                               const double* valores) {
+        if (k < CAPACIDAD_MINIMA || k > std::numeric_limits<uint32_t>::max()) return false;
+        if (numNiveles == 0 || numNiveles > 64) return false;
+        BosquejoKLL referencia(k);
+        while (referencia.niveles.size() < numNiveles) referencia.agregarNivel();
+        uint64_t total = 0, pesos = 0;
+        for (size_t h = 0; h < numNiveles; h++) {
+            if (tamanos[h] >= referencia.capacidadTotal - total) return false;
+            total += tamanos[h];
+            if (tamanos[h] > (std::numeric_limits<uint64_t>::max() - pesos) >> h) return false;
+            pesos += tamanos[h] << h;
+        }
+        if (pesos != n) return false;
+        const double* nivel = valores + tamanos[0];
+        for (size_t h = 1; h < numNiveles; h++) {
+            if (!std::is_sorted(nivel, nivel + tamanos[h])) return false;
+            nivel += tamanos[h];
+        }
+        return true;
+    }
+
+    // O(H + r) - Reponer un bosquejo guardado: los niveles van contiguos en
+    // 'valores' (primero el 0). Precondición: nivelesValidos
+    static BosquejoKLL desdeNiveles(size_t k, uint64_t n, double minimo, double maximo, uint64_t estado,
+                                    const uint64_t* tamanos, size_t numNiveles, const double* valores) {
+        BosquejoKLL bosquejo(k);
+        while (bosquejo.niveles.size() < numNiveles) bosquejo.agregarNivel();
+        for (size_t h = 0; h < numNiveles; h++) {
+            bosquejo.niveles[h].assign(valores, valores + tamanos[h]);
+            valores += tamanos[h];
+            bosquejo.retenidos += static_cast<size_t>(tamanos[h]);
+        }
+        bosquejo.n = n;
+        bosquejo.minimo = minimo;
+        bosquejo.maximo = maximo;
+        bosquejo.estado = estado;
+        return bosquejo;
+    }
+
+    uint64_t size() const { return n; }                    // O(1) - lecturas resumidas
+    size_t numRetenidos() const { return retenidos; }      // O(1) - valores en memoria
+    size_t numNiveles() const { return niveles.size(); }   // O(1)
+    size_t getK() const { return k; }                      // O(1)
+    double getMinimo() const { return minimo; }            // O(1) - exacto
+    double getMaximo() const { return maximo; }            // O(1) - exacto
+    const std::vector<double>& getNivel(size_t h) const { return niveles[h]; } // O(1) - muestras de peso 2^h
+    uint64_t getEstadoAleatorio() const { return estado; } // O(1) - para guardar y reponer
+};
+
+#endif
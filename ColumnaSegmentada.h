@@ -0,0 +1,159 @@
+#ifndef COLUMNASEGMENTADA_H
+#define COLUMNASEGMENTADA_H
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <vector>
+#include <iterator>
+#include <algorithm>
+#include <type_traits>
+
+// ColumnaSegmentada - Columna de valores en segmentos de tamaño fijo
+// Cada segmento guarda 4096 elementos alineados a línea de caché y nunca se
+// mueve: agregar es O(1) en el peor caso (a lo sumo reserva un segmento nuevo),
+// sin las copias de las realocaciones de std::vector, y las direcciones de los
+// elementos son estables. Solo el directorio de punteros crece al duplicarse
+// (n / 4096 punteros). Los kernels recorren la columna tramo a tramo.
+template <typename T>
+class ColumnaSegmentada {
+    static_assert(std::is_trivially_copyable<T>::value, "ColumnaSegmentada requiere tipos triviales");
+
+public:
+    static constexpr size_t BITS_SEGMENTO = 12;
+    static constexpr size_t TAM_SEGMENTO = size_t(1) << BITS_SEGMENTO;
+    static constexpr size_t ALINEACION = 64;
+
+private:
+    std::vector<T*> segmentos;
+    size_t n = 0;
+
+    static T* nuevoSegmento() {
+        return static_cast<T*>(::operator new(TAM_SEGMENTO * sizeof(T), std::align_val_t(ALINEACION)));
+    }
+    static void liberarSegmento(T* s) {
+        ::operator delete(s, std::align_val_t(ALINEACION));
+    }
+
+public:
+    // Iterador de solo lectura por posición lógica
+    class Iterador {
+    private:
+        const ColumnaSegmentada* columna = nullptr;
+        size_t i = 0;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        Iterador() = default;
+        Iterador(const ColumnaSegmentada* columna, size_t i) : columna(columna), i(i) {}
+
+        reference operator*() const { return (*columna)[i]; }
+        pointer operator->() const { return &(*columna)[i]; }
+        Iterador& operator++() { i++; return *this; }
+        Iterador operator++(int) { Iterador previo = *this; i++; return previo; }
+        bool operator==(const Iterador& otro) const { return i == otro.i; }
+        bool operator!=(const Iterador& otro) const { return i != otro.i; }
+    };
+
+    ColumnaSegmentada() = default;
+    ~ColumnaSegmentada() { liberar(); }
+
+    ColumnaSegmentada(const ColumnaSegmentada&) = delete;
+    ColumnaSegmentada& operator=(const ColumnaSegmentada&) = delete;
+
+    ColumnaSegmentada(ColumnaSegmentada&& otra) noexcept
+        : segmentos(std::move(otra.segmentos)), n(otra.n) {
+        otra.segmentos.clear();
+        otra.n = 0;
+    }
+    ColumnaSegmentada& operator=(ColumnaSegmentada&& otra) noexcept {
+        if (this != &otra) {
+            liberar();
+            segmentos = std::move(otra.segmentos);
+            n = otra.n;
+            otra.segmentos.clear();
+            otra.n = 0;
+        }
+        return *this;
+    }
+
+    // O(1) - Agregar al final (reserva un segmento nuevo cada 4096 elementos)
+    void push_back(const T& valor) {
+        if (n == segmentos.size() * TAM_SEGMENTO) segmentos.push_back(nuevoSegmento());
+        segmentos[n >> BITS_SEGMENTO][n & (TAM_SEGMENTO - 1)] = valor;
+        n++;
+    }
+
+    // O(k) - Agregar k elementos contiguos copiando por segmento
+    void agregar(const T* valores, size_t k) {
+        while (k > 0) {
+            if (n == segmentos.size() * TAM_SEGMENTO) segmentos.push_back(nuevoSegmento());
+            size_t desplazamiento = n & (TAM_SEGMENTO - 1);
+            size_t cuantos = std::min(k, TAM_SEGMENTO - desplazamiento);
+            std::memcpy(segmentos[n >> BITS_SEGMENTO] + desplazamiento, valores, cuantos * sizeof(T));
+            n += cuantos;
+            valores += cuantos;
+            k -= cuantos;
+        }
+    }
+
+    // O(k / 4096) - Reservar los segmentos para k elementos adicionales
+    void reservar(size_t k) {
+        size_t necesarios = (n + k + TAM_SEGMENTO - 1) >> BITS_SEGMENTO;
+        segmentos.reserve(necesarios);
+        while (segmentos.size() < necesarios) segmentos.push_back(nuevoSegmento());
+    }
+
+    // O(1) - Vaciar conservando los segmentos reservados
+    void vaciar() { n = 0; }
+
+    // O(n / 4096) - Vaciar y devolver la memoria
+    void liberar() {
+        for (T* s : segmentos) liberarSegmento(s);
+        std::vector<T*>().swap(segmentos);
+        n = 0;
+    }
+
+    // O(1) - Desplazamiento y máscara, sin divisiones
+    const T& operator[](size_t i) const { return segmentos[i >> BITS_SEGMENTO][i & (TAM_SEGMENTO - 1)]; }
+    const T& back() const { return (*this)[n - 1]; }
+
+    size_t size() const { return n; }                                   // O(1)
+    bool empty() const { return n == 0; }                               // O(1)
+    Iterador begin() const { return Iterador(this, 0); }                // O(1)
+    Iterador end() const { return Iterador(this, n); }                  // O(1)
+
+    // O(1) - Acceso por segmento para los kernels (el último puede estar incompleto)
+    size_t numSegmentos() const { return (n + TAM_SEGMENTO - 1) >> BITS_SEGMENTO; }
+    const T* segmento(size_t s) const { return segmentos[s]; }
+    size_t tamSegmento(size_t s) const { return std::min(TAM_SEGMENTO, n - (s << BITS_SEGMENTO)); }
+
+    // O(j - i) - Llamar f(datos, longitud, inicio) por cada tramo contiguo de [i, j)
+    template <typename F>
+    void recorrerTramos(size_t i, size_t j, F f) const {
+        j = std::min(j, n);
+        while (i < j) {
+            size_t desplazamiento = i & (TAM_SEGMENTO - 1);
+            size_t cuantos = std::min(j - i, TAM_SEGMENTO - desplazamiento);
+            f(segmentos[i >> BITS_SEGMENTO] + desplazamiento, cuantos, i);
+            i += cuantos;
+        }
+    }
+
+    // O(n) - Copia contigua (p. ej. para bibliotecas que exigen std::vector)
+    std::vector<T> comoVector() const {
+        std::vector<T> copia;
+        copia.reserve(n);
+        recorrerTramos(0, n, [&](const T* datos, size_t k, size_t) {
+            copia.insert(copia.end(), datos, datos + k);
+        });
+        return copia;
+    }
+};
+
+#endif
@@ -0,0 +1,192 @@
+#ifndef EJETIEMPO_H
+#define EJETIEMPO_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+#include "ColumnaSegmentada.h"
+#include "IndiceTemporal.h"
+
+// Cómo avanzar sobre un eje ordenado al resolver consultas en lote
+// - LOTE_MEZCLA: paso a paso, O(n + k); conviene con consultas densas.
+// - LOTE_GALOPE: saltos que se duplican y bisección, O(k log(n / k)); conviene
+//   con pocas consultas repartidas sobre una serie larga.
+// - LOTE_AUTOMATICO: galope si hay al menos 32 posiciones por consulta.
+enum EstrategiaLote {
+    LOTE_AUTOMATICO,
+    LOTE_MEZCLA,
+    LOTE_GALOPE
+};
+
+// EjeTiempo - Columna de marcas de tiempo (segundos desde la época)
+// Se maneja con std::shared_ptr: todos los canales muestreados en la misma
+// fila del CSV apuntan al mismo eje en lugar de guardar una copia cada uno.
+// El índice temporal se mantiene al agregar, así que buscar por tiempo nunca
+// requiere ordenar.
+class EjeTiempo {
+private:
+    ColumnaSegmentada<int64_t> tiempos;
+    IndiceTemporal indice;
+
+    // O(k log k) si no vienen ordenadas, O(k) si ya lo están - Permutación que
+    // recorre las consultas en orden de tiempo (vacía si ya están ordenadas)
+    static std::vector<size_t> ordenConsultas(const int64_t* consultas, size_t k) {
+        std::vector<size_t> orden;
+        if (std::is_sorted(consultas, consultas + k)) return orden;
+        orden.resize(k);
+        for (size_t q = 0; q < k; q++) orden[q] = q;
+        std::sort(orden.begin(), orden.end(), [&](size_t a, size_t b) { return consultas[a] < consultas[b]; });
+        return orden;
+    }
+
+    // O(log d) - Primera posición >= p con tiempo >= t en un eje ordenado, por
+    // galope desde p (d = distancia avanzada)
+    size_t galopar(size_t p, size_t limite, int64_t t) const {
+        if (p >= limite || tiempos[p] >= t) return p;
+        size_t lo = p + 1, salto = 1; // invariante: tiempos[lo - 1] < t
+        while (lo - 1 + salto < limite && tiempos[lo - 1 + salto] < t) {
+            lo += salto;
+            salto *= 2;
+        }
+        size_t hi = std::min(lo - 1 + salto, limite);
+        while (lo < hi) {
+            size_t medio = lo + (hi - lo) / 2;
+            if (tiempos[medio] < t) lo = medio + 1;
+            else hi = medio;
+        }
+        return lo;
+    }
+
+public:
+    // O(1) en orden - Sin realocaciones (columna segmentada)
+    void agregar(int64_t timestamp) {
+        indice.agregar(timestamp);
+        tiempos.push_back(timestamp);
+    }
+
+    // O(k) - Agregar k marcas contiguas (copia por segmentos)
+    void agregar(const int64_t* marcas, size_t k) {
+        for (size_t i = 0; i < k; i++) indice.agregar(marcas[i]);
+        tiempos.agregar(marcas, k);
+    }
+
+    // O(1) - Vaciar conservando los segmentos reservados
+    void vaciar() {
+        tiempos.vaciar();
+        indice = IndiceTemporal();
+    }
+
+    // O(log n) - Posición de la marca más temprana en [t0, t1) entre las primeras
+    // 'limite' posiciones (SIN_POSICION si no hay)
+    size_t primeroEnRango(int64_t t0, int64_t t1, size_t limite) const {
+        return indice.primeroEnRango(tiempos, t0, t1, limite);
+    }
+
+    // O(log n) - Posición de la marca más tardía estrictamente anterior a t entre
+    // las primeras 'limite' (la primera posición si se repite); SIN_POSICION si no hay
+    size_t anteriorA(int64_t t, size_t limite) const {
+        int64_t anterior;
+        if (!indice.tiempoAnterior(tiempos, t, limite, anterior)) return SIN_POSICION;
+        return indice.primeroEnRango(tiempos, anterior, anterior + 1, limite);
+    }
+
+    // O(log n) - Posición de la marca más temprana >= t entre las primeras 'limite'
+    size_t siguienteA(int64_t t, size_t limite) const {
+        return indice.primeroEnRango(tiempos, t, INT64_MAX, limite);
+    }
+
+    // O(n + k) ordenado, O(k log n) si no - Vecinos de k instantes en lote:
+    // anteriores[q] = anteriorA(consultas[q]), siguientes[q] = siguienteA(consultas[q]).
+    // Si el eje está ordenado se resuelven todos en una sola pasada de mezcla
+    // sobre las consultas en orden (si no vienen ordenadas se ordena una
+    // permutación, O(k log k)); si no, consulta por consulta con el índice.
+    void vecinosEnLote(const int64_t* consultas, size_t k, size_t limite,
+                       size_t* anteriores, size_t* siguientes) const {
+        limite = std::min(limite, tiempos.size());
+        if (!indice.estaOrdenado()) {
+            for (size_t q = 0; q < k; q++) {
+                anteriores[q] = anteriorA(consultas[q], limite);
+                siguientes[q] = siguienteA(consultas[q], limite);
+            }
+            return;
+        }
+        std::vector<size_t> orden = ordenConsultas(consultas, k);
+        // p = primera posición con tiempo >= consulta (y la primera de su racha);
+        // inicioRacha = primera posición de la racha de marcas iguales que termina en p - 1
+        size_t p = 0, inicioRacha = SIN_POSICION;
+        for (size_t r = 0; r < k; r++) {
+            size_t q = orden.empty() ? r : orden[r];
+            while (p < limite && tiempos[p] < consultas[q]) {
+                if (p == 0 || tiempos[p] != tiempos[p - 1]) inicioRacha = p;
+                p++;
+            }
+            anteriores[q] = inicioRacha;
+            siguientes[q] = p < limite ? p : SIN_POSICION;
+        }
+    }
+
+    // O(n + k) mezcla, O(k log(n / k)) galope, O(k log n) eje sin orden - Búsqueda
+    // exacta en lote: posiciones[q] = primeroEnRango(consultas[q], consultas[q] + 1)
+    // ('posiciones' tiene k elementos, la reserva quien llama). Las consultas
+    // pueden venir en cualquier orden (si no están ordenadas se ordena una permutación)
+    void buscarEnLote(const int64_t* consultas, size_t k, size_t limite, size_t* posiciones,
+                      EstrategiaLote estrategia = LOTE_AUTOMATICO) const {
+        limite = std::min(limite, tiempos.size());
+        if (!indice.estaOrdenado()) {
+            for (size_t q = 0; q < k; q++) posiciones[q] = primeroEnRango(consultas[q], consultas[q] + 1, limite);
+            return;
+        }
+        bool galope = estrategia == LOTE_GALOPE ||
+                      (estrategia == LOTE_AUTOMATICO && k > 0 && limite / k >= 32);
+        std::vector<size_t> orden = ordenConsultas(consultas, k);
+        size_t p = 0; // primera posición con tiempo >= consulta actual
+        for (size_t r = 0; r < k; r++) {
+            size_t q = orden.empty() ? r : orden[r];
+            if (galope) p = galopar(p, limite, consultas[q]);
+            else while (p < limite && tiempos[p] < consultas[q]) p++;
+            posiciones[q] = p < limite && tiempos[p] == consultas[q] ? p : SIN_POSICION;
+        }
+    }
+
+    // O(log n) - Menor y mayor marca entre las primeras 'limite' posiciones
+    bool extremos(size_t limite, int64_t& minimo, int64_t& maximo) const {
+        return indice.extremos(tiempos, limite, minimo, maximo);
+    }
+
+    const IndiceTemporal& getIndice() const { return indice; } // O(1)
+
+    // O(n / 4096) - Reservar los segmentos para n marcas adicionales
+    void reservar(size_t n) { tiempos.reservar(n); }
+
+    size_t size() const { return tiempos.size(); }                  // O(1)
+    int64_t operator[](size_t i) const { return tiempos[i]; }      // O(1)
+    const ColumnaSegmentada<int64_t>& columna() const { return tiempos; } // O(1)
+};
+
+// VistaTiempos - Vista de solo lectura sobre los primeros n tiempos de un eje
+// Un eje compartido puede ir adelantado respecto a un canal (la fila en curso),
+// por eso cada sensor expone solo el prefijo que corresponde a sus lecturas.
+class VistaTiempos {
+private:
+    const ColumnaSegmentada<int64_t>* tiempos = nullptr;
+    size_t n = 0;
+
+public:
+    using Iterador = ColumnaSegmentada<int64_t>::Iterador;
+
+    VistaTiempos() = default;
+    VistaTiempos(const ColumnaSegmentada<int64_t>& tiempos, size_t n) : tiempos(&tiempos), n(n) {}
+
+    Iterador begin() const { return Iterador(tiempos, 0); }      // O(1)
+    Iterador end() const { return Iterador(tiempos, n); }        // O(1)
+    size_t size() const { return n; }                            // O(1)
+    bool empty() const { return n == 0; }                        // O(1)
+    int64_t operator[](size_t i) const { return (*tiempos)[i]; } // O(1)
+
+    // O(n) - Recorrer la vista por tramos contiguos: f(datos, longitud, inicio)
+    template <typename F>
+    void recorrerTramos(F f) const { if (n > 0) tiempos->recorrerTramos(0, n, f); }
+};
+
+#endif
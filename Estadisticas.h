@@ -0,0 +1,116 @@
+#ifndef ESTADISTICAS_H
+#define ESTADISTICAS_H
+
+#include <cstddef>
+#include <cmath>
+#include <algorithm>
+
+// SumaCompensada - Suma de Neumaier: acumula el error de redondeo de cada
+// suma en un término de compensación, así el total no se degrada con n.
+struct SumaCompensada {
+    double suma = 0.0;
+    double compensacion = 0.0;
+
+    // O(1)
+    void agregar(double v) {
+        double t = suma + v;
+        if (std::fabs(suma) >= std::fabs(v)) compensacion += (suma - t) + v;
+        else compensacion += (v - t) + suma;
+        suma = t;
+    }
+
+    // O(1) - Combinar dos sumas parciales (bloques o hilos)
+    void combinar(const SumaCompensada& otra) {
+        agregar(otra.suma);
+        compensacion += otra.compensacion;
+    }
+
+    double valor() const { return suma + compensacion; } // O(1)
+};
+
+// MomentosWelford - Media y suma de cuadrados de las desviaciones (m2) de una
+// serie, mantenidas con el método de Welford: cada valor corrige la media en
+// delta / n, sin restar sumas grandes, así la varianza no pierde precisión
+// aunque la media sea grande frente a la dispersión. El conteo lo lleva quien
+// los contiene. Dos tramos se combinan con la fórmula de Chan et al.
+struct MomentosWelford {
+    double media = 0.0;
+    double m2 = 0.0;
+
+    // O(1) - Incorporar v; 'n' es el conteo ya incluyendo a v
+    void agregar(double v, size_t n) {
+        double delta = v - media;
+        media += delta / static_cast<double>(n);
+        m2 += delta * (v - media);
+    }
+
+    // O(1) - Quitar v (inversa de agregar); 'n' es el conteo antes de quitarlo
+    void quitar(double v, size_t n) {
+        if (n <= 1) { *this = MomentosWelford(); return; }
+        double delta = v - media;
+        media -= delta / static_cast<double>(n - 1);
+        m2 = std::max(0.0, m2 - delta * (v - media));
+    }
+
+    // O(1) - Combinar con los momentos de otro tramo (nA y nB, los conteos de cada uno):
+    // delta = mediaB - mediaA; media += delta·nB/n; m2 += m2B + delta²·nA·nB/n
+    void combinar(size_t nA, const MomentosWelford& otro, size_t nB) {
+        if (nB == 0) return;
+        if (nA == 0) { *this = otro; return; }
+        double total = static_cast<double>(nA) + static_cast<double>(nB);
+        double delta = otro.media - media;
+        media += delta * (static_cast<double>(nB) / total);
+        m2 += otro.m2 + delta * delta * (static_cast<double>(nA) * static_cast<double>(nB) / total);
+    }
+
+    // O(1) - Varianza muestral (divide por n - 1); 0 con menos de dos valores
+    double varianza(size_t n) const { return n < 2 ? 0.0 : m2 / static_cast<double>(n - 1); }
+};
+
+// Agregados - Mínimo, máximo (con su índice), conteo y suma de una serie
+// Ante empates se conserva la primera aparición, igual que std::min_element
+// y std::max_element, para que los resultados no cambien respecto al recorrido.
+struct Agregados {
+    size_t n = 0;
+    double minimo = 0.0;
+    double maximo = 0.0;
+    size_t indiceMinimo = 0;
+    size_t indiceMaximo = 0;
+    SumaCompensada suma;
+    MomentosWelford momentos;
+
+    // O(1) - Incorporar el valor que ocupa la posición 'indice' de la serie
+    void agregar(double v, size_t indice) {
+        if (n == 0 || v < minimo) { minimo = v; indiceMinimo = indice; }
+        if (n == 0 || v > maximo) { maximo = v; indiceMaximo = indice; }
+        suma.agregar(v);
+        n++;
+        momentos.agregar(v, n);
+    }
+
+    // O(1) - Combinar con los agregados de otro tramo (índices absolutos)
+    void combinar(const Agregados& otro) {
+        if (otro.n == 0) return;
+        if (n == 0) { *this = otro; return; }
+        if (otro.minimo < minimo || (otro.minimo == minimo && otro.indiceMinimo < indiceMinimo)) {
+            minimo = otro.minimo;
+            indiceMinimo = otro.indiceMinimo;
+        }
+        if (otro.maximo > maximo || (otro.maximo == maximo && otro.indiceMaximo < indiceMaximo)) {
+            maximo = otro.maximo;
+            indiceMaximo = otro.indiceMaximo;
+        }
+        suma.combinar(otro.suma);
+        momentos.combinar(n, otro.momentos, otro.n);
+        n += otro.n;
+    }
+
+    // O(1)
+    double promedio() const { return n == 0 ? 0.0 : suma.valor() / n; }
+
+    // O(1) - Varianza muestral y desviación estándar (Welford)
+    double varianza() const { return momentos.varianza(n); }
+    double desviacionEstandar() const { return std::sqrt(varianza()); }
+};
+
+#endif
@@ -0,0 +1,140 @@
+#ifndef HISTOGRAMA_H
+#define HISTOGRAMA_H
+
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include "ResumenBloques.h"
+
+// Histograma - Conteos por cubetas de bordes fijos
+// Con bordes b0 < b1 < ... < b(m-1) hay m + 1 cubetas: la 0 es (-inf, b0), la
+// i es [b(i-1), b(i)) y la última es [b(m-1), +inf). NaN cae en la cubeta 0.
+class Histograma {
+private:
+    std::vector<double> bordes;
+    std::vector<uint64_t> conteos;
+    uint64_t total = 0;
+
+public:
+    Histograma() : conteos(1, 0) {}
+
+    // O(m) - Precondición: bordes finitos y estrictamente crecientes (ver bordesValidos)
+    explicit Histograma(std::vector<double> bordesCubetas)
+        : bordes(std::move(bordesCubetas)), conteos(bordes.size() + 1, 0) {}
+
+    // O(m) - Bordes finitos y estrictamente crecientes
+    static bool bordesValidos(const std::vector<double>& bordes) {
+        for (size_t i = 0; i < bordes.size(); i++) {
+            if (!std::isfinite(bordes[i]) || (i > 0 && bordes[i] <= bordes[i - 1])) return false;
+        }
+        return true;
+    }
+
+    // O(log m) sin saltos - Cubeta de 'valor': cuántos bordes son <= valor.
+    // Bisección de longitud fija; la comparación elige el avance con un
+    // movimiento condicional, así no hay saltos que dependan del dato
+    size_t cubeta(double valor) const {
+        size_t n = bordes.size();
+        if (n == 0) return 0;
+        const double* base = bordes.data();
+        while (n > 1) {
+            size_t mitad = n / 2;
+            base = base[mitad] <= valor ? base + mitad : base;
+            n -= mitad;
+        }
+        return static_cast<size_t>(base - bordes.data()) + (*base <= valor);
+    }
+
+    // O(log m) - Contar un valor
+    void agregar(double valor) {
+        conteos[cubeta(valor)]++;
+        total++;
+    }
+
+    // O(1) - Sumar 'cuantos' a la cubeta c
+    void sumar(size_t c, uint64_t cuantos) {
+        conteos[c] += cuantos;
+        total += cuantos;
+    }
+
+    // O(m) - Combinar con otro histograma de los mismos bordes
+    void combinar(const Histograma& otro) {
+        for (size_t c = 0; c < conteos.size(); c++) conteos[c] += otro.conteos[c];
+        total += otro.total;
+    }
+
+    // O(m) - Mismos bordes, conteos en cero
+    Histograma vacio() const { return Histograma(bordes); }
+
+    // O(1) - Fracción de los valores contados que cayó en la cubeta c
+    double fraccion(size_t c) const {
+        return total == 0 ? 0.0 : static_cast<double>(conteos[c]) / static_cast<double>(total);
+    }
+
+    uint64_t conteo(size_t c) const { return conteos[c]; }            // O(1)
+    uint64_t getTotal() const { return total; }                       // O(1)
+    size_t numCubetas() const { return conteos.size(); }              // O(1)
+    const std::vector<double>& getBordes() const { return bordes; }   // O(1)
+};
+
+// HistogramaBloques - Histograma total más uno por cada bloque de 1024 lecturas
+// Los bloques coinciden con los de ResumenBloques, así una consulta por rango de
+// tiempo suma los conteos de los bloques contenidos y solo recorre los bordes.
+// Los conteos por bloque caben en 16 bits (a lo sumo 1024 por cubeta).
+// Sin bloques (comprimido o con retención) solo se mantiene el total.
+class HistogramaBloques {
+private:
+    Histograma total;
+    std::vector<uint16_t> porBloque; // numCubetas() conteos por bloque, contiguos
+    size_t n = 0;
+    bool conBloques = true;
+
+public:
+    // O(m) - Precondición: Histograma::bordesValidos(bordes)
+    explicit HistogramaBloques(std::vector<double> bordes) : total(std::move(bordes)) {}
+
+    // O(log m) - Contar la lectura de la posición siguiente
+    void agregar(double valor) {
+        size_t c = total.cubeta(valor);
+        total.sumar(c, 1);
+        if (conBloques) {
+            if (n % PUNTOS_POR_RESUMEN == 0) porBloque.resize(porBloque.size() + total.numCubetas(), 0);
+            porBloque[porBloque.size() - total.numCubetas() + c]++;
+        }
+        n++;
+    }
+
+    // O(k log m) - Contar k lecturas contiguas
+    void agregar(const double* valores, size_t k) {
+        for (size_t i = 0; i < k; i++) agregar(valores[i]);
+    }
+
+    // O(m) - Reemplazar los conteos totales por unos guardados (numCubetas()
+    // conteos; p. ej. de una instantánea, con lecturas que ya no están)
+    void restaurarTotal(const uint64_t* conteos) {
+        Histograma repuesto = total.vacio();
+        for (size_t c = 0; c < repuesto.numCubetas(); c++) repuesto.sumar(c, conteos[c]);
+        total = std::move(repuesto);
+    }
+
+    // O(1) - Dejar de mantener los bloques (las posiciones ya no son las del resumen)
+    void descartarBloques() {
+        porBloque.clear();
+        porBloque.shrink_to_fit();
+        conBloques = false;
+    }
+
+    // O(m) - Sumar los conteos del bloque b a 'h' (mismos bordes)
+    void sumarBloque(size_t b, Histograma& h) const {
+        const uint16_t* conteos = &porBloque[b * total.numCubetas()];
+        for (size_t c = 0; c < total.numCubetas(); c++) h.sumar(c, conteos[c]);
+    }
+
+    const Histograma& getTotal() const { return total; }       // O(1)
+    bool tieneBloques() const { return conBloques; }            // O(1)
+};
+
+#endif
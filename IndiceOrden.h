@@ -0,0 +1,155 @@
+#ifndef INDICEORDEN_H
+#define INDICEORDEN_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include "OrdenamientoRadix.h"
+
+// IndiceOrden - Permutación ordenada de las lecturas (estadísticos de orden)
+// Guarda los pares (valor, posición) ordenados, repartidos en bloques de entre
+// 256 y 512 entradas; el último par de cada bloque se repite en un arreglo
+// contiguo para ubicar bloques por bisección sin saltar entre bloques, y un
+// árbol de Fenwick sobre los tamaños da cuántas entradas hay antes de cada uno:
+// - agregar: O(log n) para ubicar el bloque + O(B) para insertar en él (B <= 512;
+//   al llenarse un bloque se parte en dos y se rehace el Fenwick, O(n / B)).
+// - seleccionar (k-ésimo menor) y rango (cuántos valores < v): O(log n).
+// - recorrer en orden: O(n), sin volver a ordenar.
+// Ante valores iguales el orden es por posición (ordenamiento estable).
+class IndiceOrden {
+private:
+    using Entrada = std::pair<double, size_t>; // (valor, posición)
+
+    static constexpr size_t TAM_BLOQUE = 256;
+
+    std::vector<std::vector<Entrada>> bloques;
+    std::vector<Entrada> ultimos; // ultimos[b] == bloques[b].back()
+    std::vector<size_t> fenwick; // base 1: fenwick[b] suma tamaños de un tramo de bloques
+    size_t n = 0;
+
+    // O(b) - Reconstruir el árbol de Fenwick a partir de los tamaños de los bloques
+    void reconstruirFenwick() {
+        fenwick.assign(bloques.size() + 1, 0);
+        for (size_t b = 1; b <= bloques.size(); b++) {
+            fenwick[b] += bloques[b - 1].size();
+            size_t padre = b + (b & (~b + 1));
+            if (padre <= bloques.size()) fenwick[padre] += fenwick[b];
+        }
+    }
+
+    // O(log b) - Entradas en los bloques [0, b)
+    size_t prefijo(size_t b) const {
+        size_t suma = 0;
+        for (; b > 0; b -= b & (~b + 1)) suma += fenwick[b];
+        return suma;
+    }
+
+    // O(log b) - Bloque que contiene la entrada de rango k; 'k' queda relativo al bloque
+    size_t bloqueDeRango(size_t& k) const {
+        size_t b = 0, paso = 1;
+        while (paso * 2 <= bloques.size()) paso *= 2;
+        for (; paso > 0; paso /= 2) {
+            if (b + paso <= bloques.size() && fenwick[b + paso] <= k) {
+                b += paso;
+                k -= fenwick[b];
+            }
+        }
+        return b;
+    }
+
+    // O(log b) - Primer bloque cuyo último par no es menor que 'e' (el último si ninguno)
+    size_t bloqueDe(const Entrada& e) const {
+        size_t b = static_cast<size_t>(std::lower_bound(ultimos.begin(), ultimos.end(), e) - ultimos.begin());
+        return std::min(b, bloques.size() - 1);
+    }
+
+public:
+    IndiceOrden() = default;
+
+    // O(n) - Construir a partir de una columna de valores (posiciones 0..n-1) con
+    // ordenamiento radix (O(n log n) con std::sort si n no cabe en 32 bits)
+    template <typename Columna>
+    explicit IndiceOrden(const Columna& valores) : n(valores.size()) {
+        std::vector<Entrada> todas;
+        todas.reserve(n);
+        if (n <= UINT32_MAX) {
+            std::vector<ParValorIndice> pares(n);
+            for (size_t i = 0; i < n; i++) pares[i] = {valores[i], static_cast<uint32_t>(i)};
+            ordenarRadixParalelo(pares.data(), n);
+            for (const ParValorIndice& p : pares) todas.emplace_back(valores[p.indice], p.indice);
+        } else {
+            for (size_t i = 0; i < n; i++) todas.emplace_back(valores[i], i);
+            std::sort(todas.begin(), todas.end());
+        }
+        for (size_t i = 0; i < n; i += TAM_BLOQUE) {
+            size_t fin = std::min(n, i + TAM_BLOQUE);
+            bloques.emplace_back(todas.begin() + i, todas.begin() + fin);
+            ultimos.push_back(todas[fin - 1]);
+        }
+        reconstruirFenwick();
+    }
+
+    // O(log n + B) - Incorporar el valor de la posición 'posicion'
+    void agregar(double valor, size_t posicion) {
+        Entrada e(valor, posicion);
+        if (bloques.empty()) {
+            bloques.push_back({e});
+            ultimos.push_back(e);
+            reconstruirFenwick();
+            n++;
+            return;
+        }
+        size_t b = bloqueDe(e);
+        std::vector<Entrada>& bloque = bloques[b];
+        bloque.insert(std::upper_bound(bloque.begin(), bloque.end(), e), e);
+        ultimos[b] = bloque.back();
+        n++;
+        if (bloque.size() >= 2 * TAM_BLOQUE) {
+            std::vector<Entrada> mitad(bloque.begin() + TAM_BLOQUE, bloque.end());
+            bloque.resize(TAM_BLOQUE);
+            ultimos[b] = bloque.back();
+            ultimos.insert(ultimos.begin() + b + 1, mitad.back());
+            bloques.insert(bloques.begin() + b + 1, std::move(mitad));
+            reconstruirFenwick();
+        } else {
+            for (size_t i = b + 1; i < fenwick.size(); i += i & (~i + 1)) fenwick[i]++;
+        }
+    }
+
+    // O(log n) - Posición de la lectura con el k-ésimo menor valor (k desde 0)
+    // Precondición: k < size()
+    size_t seleccionar(size_t k) const {
+        size_t b = bloqueDeRango(k);
+        return bloques[b][k].second;
+    }
+
+    // O(log n) - Valor del k-ésimo menor (k < size())
+    double valorKesimo(size_t k) const {
+        size_t b = bloqueDeRango(k);
+        return bloques[b][k].first;
+    }
+
+    // O(log n) - Cuántas lecturas tienen valor estrictamente menor que 'valor'
+    // (también es la posición en el orden de la primera aparición de 'valor')
+    size_t rango(double valor) const {
+        auto menor = [](const Entrada& e, double v) { return e.first < v; };
+        size_t b = static_cast<size_t>(std::lower_bound(ultimos.begin(), ultimos.end(), valor, menor) - ultimos.begin());
+        if (b == bloques.size()) return n;
+        const std::vector<Entrada>& bloque = bloques[b];
+        return prefijo(b) + static_cast<size_t>(std::lower_bound(bloque.begin(), bloque.end(), valor, menor) - bloque.begin());
+    }
+
+    // O(n) - Llamar f(valor, posición) en orden ascendente
+    template <typename F>
+    void recorrer(F f) const {
+        for (const auto& bloque : bloques) {
+            for (const Entrada& e : bloque) f(e.first, e.second);
+        }
+    }
+
+    size_t size() const { return n; } // O(1)
+};
+
+#endif
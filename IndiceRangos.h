@@ -0,0 +1,163 @@
+#ifndef INDICERANGOS_H
+#define INDICERANGOS_H
+
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+#include "ColumnaSegmentada.h"
+#include "IndiceTemporal.h"
+
+// Índices de mínimo/máximo por rango de posiciones [i, j) sobre una columna de
+// lecturas. Ambos trabajan sobre hojas de 32 lecturas consecutivas: el índice
+// resuelve las hojas completas del rango y las (a lo sumo dos) hojas parciales
+// de los bordes se recorren, así la memoria se divide entre 32 (árbol: ~1 byte
+// por lectura). Como en Agregados, ante empates gana la primera aparición.
+constexpr size_t PUNTOS_POR_HOJA = 32;
+
+// Posiciones del mínimo y del máximo de un tramo (SIN_POSICION si está vacío)
+struct ExtremosTramo {
+    size_t indiceMinimo = SIN_POSICION;
+    size_t indiceMaximo = SIN_POSICION;
+
+    bool vacio() const { return indiceMinimo == SIN_POSICION; } // O(1)
+
+    // O(1) - Incorporar los extremos de otro tramo (valores leídos de la columna)
+    // Retorna true si alguno de los dos cambió
+    bool combinar(const ExtremosTramo& otro, const ColumnaSegmentada<double>& valores) {
+        if (otro.vacio()) return false;
+        if (vacio()) { *this = otro; return true; }
+        bool cambio = false;
+        double m = valores[otro.indiceMinimo], actualMin = valores[indiceMinimo];
+        if (m < actualMin || (m == actualMin && otro.indiceMinimo < indiceMinimo)) {
+            indiceMinimo = otro.indiceMinimo;
+            cambio = true;
+        }
+        double M = valores[otro.indiceMaximo], actualMax = valores[indiceMaximo];
+        if (M > actualMax || (M == actualMax && otro.indiceMaximo < indiceMaximo)) {
+            indiceMaximo = otro.indiceMaximo;
+            cambio = true;
+        }
+        return cambio;
+    }
+};
+
+// O(j - i) - Extremos de [i, j) recorriendo la columna (bordes y respaldo)
+inline ExtremosTramo recorrerExtremos(const ColumnaSegmentada<double>& valores, size_t i, size_t j) {
+    ExtremosTramo e;
+    if (i >= j) return e;
+    e.indiceMinimo = e.indiceMaximo = i;
+    double minimo = valores[i], maximo = valores[i];
+    valores.recorrerTramos(i, j, [&](const double* datos, size_t k, size_t inicio) {
+        for (size_t p = 0; p < k; p++) {
+            if (datos[p] < minimo) { minimo = datos[p]; e.indiceMinimo = inicio + p; }
+            if (datos[p] > maximo) { maximo = datos[p]; e.indiceMaximo = inicio + p; }
+        }
+    });
+    return e;
+}
+
+// TablaDispersa - Tabla dispersa (sparse table) para datos que ya no cambian
+// Nivel k: extremos de las 2^k hojas que empiezan en cada hoja. Una consulta
+// cubre las hojas completas con dos entradas solapadas: O(1) más los bordes.
+// Se construye una vez en O(n + (n/32) log(n/32)); si después llegan lecturas
+// nuevas sigue respondiendo para las primeras size() posiciones.
+class TablaDispersa {
+private:
+    std::vector<std::vector<ExtremosTramo>> niveles;
+    size_t n = 0;
+
+public:
+    TablaDispersa() = default;
+
+    // O(n + (n/32) log(n/32))
+    explicit TablaDispersa(const ColumnaSegmentada<double>& valores) : n(valores.size()) {
+        size_t hojas = n / PUNTOS_POR_HOJA; // solo hojas completas; el resto es borde
+        if (hojas == 0) return;
+        niveles.emplace_back(hojas);
+        for (size_t h = 0; h < hojas; h++) {
+            niveles[0][h] = recorrerExtremos(valores, h * PUNTOS_POR_HOJA, (h + 1) * PUNTOS_POR_HOJA);
+        }
+        for (size_t ancho = 2; ancho <= hojas; ancho *= 2) {
+            const std::vector<ExtremosTramo>& previo = niveles.back();
+            std::vector<ExtremosTramo> nivel(hojas - ancho + 1);
+            for (size_t h = 0; h < nivel.size(); h++) {
+                nivel[h] = previo[h];
+                nivel[h].combinar(previo[h + ancho / 2], valores);
+            }
+            niveles.push_back(std::move(nivel));
+        }
+    }
+
+    // O(1) + O(64) de bordes - Extremos de [i, j); precondición: j <= size()
+    ExtremosTramo consultar(const ColumnaSegmentada<double>& valores, size_t i, size_t j) const {
+        size_t hi = (i + PUNTOS_POR_HOJA - 1) / PUNTOS_POR_HOJA; // primera hoja completa
+        size_t hj = j / PUNTOS_POR_HOJA;                         // fin de las hojas completas
+        if (hi >= hj) return recorrerExtremos(valores, i, j);
+        ExtremosTramo e = recorrerExtremos(valores, i, hi * PUNTOS_POR_HOJA);
+        size_t k = 0;
+        while ((size_t(2) << k) <= hj - hi) k++;
+        e.combinar(niveles[k][hi], valores);
+        e.combinar(niveles[k][hj - (size_t(1) << k)], valores);
+        e.combinar(recorrerExtremos(valores, hj * PUNTOS_POR_HOJA, j), valores);
+        return e;
+    }
+
+    size_t size() const { return n; } // O(1) - posiciones cubiertas
+};
+
+// ArbolSegmentos - Árbol de segmentos sobre las hojas para datos que crecen
+// Agregar es O(log(n/32)) por lectura en el peor caso: se actualiza la hoja y
+// se sube solo mientras el nodo cambie (si un ancestro no toma la lectura
+// nueva, tampoco la toman los de arriba). Sin tendencia, la subida se corta
+// pronto. Con una serie con tendencia, en cambio, cada lectura es un nuevo
+// extremo y sube hasta la raíz. Al llenarse se duplica la capacidad y se
+// reconstruye en O(n/32) (amortizado O(1) por lectura). Las consultas son
+// O(log n) más los bordes.
+class ArbolSegmentos {
+private:
+    std::vector<ExtremosTramo> nodos; // nodos[1] es la raíz; hojas en [capacidad, 2 * capacidad)
+    size_t capacidad = 0;             // hojas (potencia de 2)
+    size_t n = 0;
+
+    // O(capacidad) - Duplicar la capacidad y recalcular los nodos internos
+    void crecer(const ColumnaSegmentada<double>& valores) {
+        size_t nueva = capacidad == 0 ? 1 : capacidad * 2;
+        std::vector<ExtremosTramo> nuevos(2 * nueva);
+        std::copy(nodos.begin() + capacidad, nodos.begin() + 2 * capacidad, nuevos.begin() + nueva);
+        for (size_t k = nueva - 1; k >= 1; k--) {
+            nuevos[k] = nuevos[2 * k];
+            nuevos[k].combinar(nuevos[2 * k + 1], valores);
+        }
+        nodos.swap(nuevos);
+        capacidad = nueva;
+    }
+
+public:
+    // O(k log(n/32)) - Incorporar las posiciones [size(), hasta) de la columna
+    void agregar(const ColumnaSegmentada<double>& valores, size_t hasta) {
+        for (; n < hasta; n++) {
+            size_t hoja = n / PUNTOS_POR_HOJA;
+            if (hoja >= capacidad) crecer(valores);
+            ExtremosTramo punto{n, n};
+            for (size_t k = capacidad + hoja; k >= 1 && nodos[k].combinar(punto, valores); k /= 2) {}
+        }
+    }
+
+    // O(log n) + O(64) de bordes - Extremos de [i, j); precondición: j <= size()
+    ExtremosTramo consultar(const ColumnaSegmentada<double>& valores, size_t i, size_t j) const {
+        size_t hi = (i + PUNTOS_POR_HOJA - 1) / PUNTOS_POR_HOJA;
+        size_t hj = j / PUNTOS_POR_HOJA;
+        if (hi >= hj) return recorrerExtremos(valores, i, j);
+        ExtremosTramo e = recorrerExtremos(valores, i, hi * PUNTOS_POR_HOJA);
+        for (size_t a = hi + capacidad, b = hj + capacidad; a < b; a /= 2, b /= 2) {
+            if (a & 1) e.combinar(nodos[a++], valores);
+            if (b & 1) e.combinar(nodos[--b], valores);
+        }
+        e.combinar(recorrerExtremos(valores, hj * PUNTOS_POR_HOJA, j), valores);
+        return e;
+    }
+
+    size_t size() const { return n; } // O(1)
+};
+
+#endif
@@ -0,0 +1,191 @@
+#ifndef INDICETEMPORAL_H
+#define INDICETEMPORAL_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include "ColumnaSegmentada.h"
+
+// Posición inexistente (búsqueda sin resultado)
+constexpr size_t SIN_POSICION = SIZE_MAX;
+
+// IndiceTemporal - Índice por tiempo de una columna de marcas, mantenido al agregar
+// - Esqueleto ordenado: cada marca que no retrocede respecto al máximo visto se
+//   agrega a un tramo de posiciones contiguas [inicio, fin). Los tramos quedan
+//   ordenados entre sí, así que se buscan por bisección sin ordenar nada.
+// - Fuera de orden: las marcas que retroceden van a un índice disperso de pares
+//   (tiempo, posición) organizado en niveles ordenados (método logarítmico):
+//   una racha de marcas fuera de orden pero crecientes (p. ej. un reloj que se
+//   reinició) se acumula en el nivel abierto, y al cerrarse se fusiona con los
+//   niveles de tamaño parecido, así cada nivel duplica al siguiente y hay
+//   O(log k) niveles. Con datos en orden no hay niveles y hay un solo tramo.
+// Buscar cuesta O(log n) con datos en orden y O(log n + log² k) en general.
+// Las consultas reciben un 'limite': solo se consideran las posiciones < limite
+// (un sensor sobre un eje compartido solo ve su prefijo).
+class IndiceTemporal {
+private:
+    struct Tramo {
+        size_t inicio;
+        size_t fin;
+        int64_t ultimo;
+    };
+
+    using Entrada = std::pair<int64_t, size_t>; // (tiempo, posición)
+
+    std::vector<Tramo> tramos;
+    std::vector<std::vector<Entrada>> niveles; // cada uno ordenado; tamaños decrecientes
+    bool nivelAbierto = false;                 // el último nivel aún recibe su racha
+    size_t totalFueraDeOrden = 0;
+    size_t n = 0;
+
+    // O(k) amortizado O(log k) - Fusionar el último nivel con los anteriores
+    // mientras no sea menor que la mitad del que lo precede
+    void compactar() {
+        while (niveles.size() >= 2 && niveles[niveles.size() - 2].size() <= 2 * niveles.back().size()) {
+            std::vector<Entrada>& a = niveles[niveles.size() - 2];
+            std::vector<Entrada>& b = niveles.back();
+            std::vector<Entrada> fusion(a.size() + b.size());
+            std::merge(a.begin(), a.end(), b.begin(), b.end(), fusion.begin());
+            niveles.pop_back();
+            niveles.back().swap(fusion);
+        }
+    }
+
+public:
+    // O(1) en orden, O(log k) amortizado fuera de orden (k = marcas fuera de orden)
+    void agregar(int64_t tiempo) {
+        if (tramos.empty() || tiempo >= tramos.back().ultimo) {
+            if (!tramos.empty() && tramos.back().fin == n) {
+                tramos.back().fin++;
+                tramos.back().ultimo = tiempo;
+            } else {
+                tramos.push_back({n, n + 1, tiempo});
+            }
+        } else {
+            bool continuaRacha = nivelAbierto && niveles.back().back().second + 1 == n &&
+                                 tiempo >= niveles.back().back().first;
+            if (!continuaRacha) {
+                compactar();
+                niveles.emplace_back();
+                nivelAbierto = true;
+            }
+            niveles.back().emplace_back(tiempo, n);
+            totalFueraDeOrden++;
+        }
+        n++;
+    }
+
+    // O(log n + log² k) - Posición de la marca más temprana en [t0, t1) entre las posiciones
+    // < limite (ante empates, la de menor posición); SIN_POSICION si no hay
+    size_t primeroEnRango(const ColumnaSegmentada<int64_t>& tiempos, int64_t t0, int64_t t1, size_t limite) const {
+        if (t0 >= t1) return SIN_POSICION;
+        size_t mejor = SIN_POSICION;
+
+        // Esqueleto: primer tramo cuyo último tiempo alcanza t0, y bisección dentro
+        auto tramo = std::lower_bound(tramos.begin(), tramos.end(), t0,
+                                      [](const Tramo& t, int64_t valor) { return t.ultimo < valor; });
+        if (tramo != tramos.end()) {
+            size_t lo = tramo->inicio, hi = tramo->fin;
+            while (lo < hi) {
+                size_t medio = lo + (hi - lo) / 2;
+                if (tiempos[medio] < t0) lo = medio + 1;
+                else hi = medio;
+            }
+            if (lo < limite && tiempos[lo] < t1) mejor = lo;
+        }
+
+        // Fuera de orden: en cada nivel, el primer par >= (t0, 0) con posición visible
+        for (const auto& nivel : niveles) {
+            auto it = std::lower_bound(nivel.begin(), nivel.end(), Entrada(t0, 0));
+            for (; it != nivel.end() && it->first < t1; ++it) {
+                if (it->second >= limite) continue; // posiciones aún no visibles (pocas)
+                if (mejor == SIN_POSICION || it->first < tiempos[mejor] ||
+                    (it->first == tiempos[mejor] && it->second < mejor)) {
+                    mejor = it->second;
+                }
+                break;
+            }
+        }
+        return mejor;
+    }
+
+    // O(log n + log² k) - Mayor marca estrictamente menor que t entre las posiciones
+    // < limite (false si no hay)
+    bool tiempoAnterior(const ColumnaSegmentada<int64_t>& tiempos, int64_t t, size_t limite, int64_t& anterior) const {
+        limite = std::min(limite, n);
+        if (limite == 0) return false;
+        bool hay = false;
+
+        // Esqueleto: está ordenado en posición y en tiempo, así que el candidato
+        // es la última marca < t o la última visible, la que esté antes
+        auto tramo = std::lower_bound(tramos.begin(), tramos.end(), t,
+                                      [](const Tramo& x, int64_t valor) { return x.ultimo < valor; });
+        size_t candidato = SIN_POSICION;
+        if (tramo == tramos.end()) {
+            candidato = tramos.back().fin - 1;
+        } else {
+            size_t lo = tramo->inicio, hi = tramo->fin;
+            while (lo < hi) {
+                size_t medio = lo + (hi - lo) / 2;
+                if (tiempos[medio] < t) lo = medio + 1;
+                else hi = medio;
+            }
+            if (lo > tramo->inicio) candidato = lo - 1;
+            else if (tramo != tramos.begin()) candidato = (tramo - 1)->fin - 1;
+        }
+        if (candidato != SIN_POSICION) {
+            auto visible = std::upper_bound(tramos.begin(), tramos.end(), limite - 1,
+                                            [](size_t posicion, const Tramo& x) { return posicion < x.inicio; });
+            --visible;
+            candidato = std::min(candidato, std::min(visible->fin, limite) - 1);
+            anterior = tiempos[candidato];
+            hay = true;
+        }
+
+        // Fuera de orden: en cada nivel, el último par < (t, 0) con posición visible
+        for (const auto& nivel : niveles) {
+            auto it = std::lower_bound(nivel.begin(), nivel.end(), Entrada(t, 0));
+            while (it != nivel.begin()) {
+                --it;
+                if (it->second >= limite) continue;
+                if (!hay || it->first > anterior) anterior = it->first;
+                hay = true;
+                break;
+            }
+        }
+        return hay;
+    }
+
+    // O(1) - Todas las marcas llegaron sin retroceder: las posiciones están
+    // ordenadas por tiempo y se pueden recorrer en una sola pasada
+    bool estaOrdenado() const { return niveles.empty(); }
+
+    // O(log n + log k) - Menor y mayor marca entre las posiciones < limite (false si no hay)
+    bool extremos(const ColumnaSegmentada<int64_t>& tiempos, size_t limite, int64_t& minimo, int64_t& maximo) const {
+        limite = std::min(limite, n);
+        if (limite == 0) return false;
+        minimo = tiempos[0]; // la primera marca siempre abre el esqueleto
+        for (const auto& nivel : niveles) {
+            for (const Entrada& entrada : nivel) {
+                if (entrada.second >= limite) continue;
+                minimo = std::min(minimo, entrada.first);
+                break;
+            }
+        }
+        // El máximo es la última marca del esqueleto visible (las de fuera de
+        // orden son, por construcción, menores que una marca anterior)
+        auto tramo = std::upper_bound(tramos.begin(), tramos.end(), limite - 1,
+                                      [](size_t posicion, const Tramo& t) { return posicion < t.inicio; });
+        --tramo;
+        maximo = tiempos[std::min(tramo->fin, limite) - 1];
+        return true;
+    }
+
+    size_t numTramos() const { return tramos.size(); }             // O(1)
+    size_t numFueraDeOrden() const { return totalFueraDeOrden; }   // O(1)
+    size_t numNiveles() const { return niveles.size(); }           // O(1)
+};
+
+#endif
@@ -0,0 +1,381 @@
+#ifndef INSTANTANEA_H
+#define INSTANTANEA_H
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "ArchivoMapeado.h"
+#include "Estadisticas.h"
+#include "SerieComprimida.h"
+#include "BosquejoCuantiles.h"
+#include "Histograma.h"
+
+#if defined(_WIN32)
+    #ifndef NOMINMAX
+    #define NOMINMAX
+    #endif
+    #include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+// Formato binario columnar de instantáneas de SistemaSensores (versión 3)
+//
+//   [CabeceraInstantanea]
+//   [SensorInstantanea x numSensores]
+//   [EjeInstantanea x numEjes]
+//   [datos: ids, unidades, columnas de tiempos/valores, bloques comprimidos,
+//           bosquejos de cuantiles, histogramas]
+//
+// Todos los campos son de ancho fijo, en el orden de bytes de la máquina
+// (marcaOrden lo verifica), y cada sección de datos empieza alineada a 8 bytes:
+// al mapear el archivo las columnas se leen como int64_t/double sin
+// deserializar. Los ejes compartidos por varios sensores se guardan una vez.
+// Cada sensor lleva sus agregados ya calculados (desde la versión 2, con los
+// momentos de Welford para la varianza). Desde la versión 3 también su bosquejo
+// de cuantiles y los totales de su histograma: resumen todo lo recibido, y con
+// retención no se podrían rehacer desde la ventana guardada.
+
+constexpr char MAGIA_INSTANTANEA[8] = {'S', 'E', 'N', 'S', 'N', 'A', 'P', '\0'};
+constexpr uint32_t VERSION_INSTANTANEA = 3;
+constexpr uint32_t MARCA_ORDEN_BYTES = 0x01020304;
+constexpr uint64_t SIN_EJE = UINT64_MAX;
+
+enum TipoSensorInstantanea : uint32_t {
+    TIPO_DESCONOCIDO = 0,
+    TIPO_TEMPERATURA = 1,
+    TIPO_HUMEDAD = 2
+};
+
+enum ModoInstantanea : uint32_t {
+    MODO_CRUDO = 0,       // columna de valores + eje
+    MODO_COMPRIMIDO = 1,  // bloques Gorilla (los tiempos van dentro de cada bloque)
+    MODO_RETENCION = 2    // contenido de la ventana + eje propio + política
+};
+
+// O(1) - Redondear hacia arriba a múltiplo de 8
+inline uint64_t alinear8(uint64_t n) { return (n + 7) & ~uint64_t(7); }
+
+struct CabeceraInstantanea {
+    char magia[8];
+    uint32_t version;
+    uint32_t marcaOrden;
+    uint64_t numSensores;
+    uint64_t numEjes;
+    uint64_t tamanoArchivo;
+};
+
+// Agregados con campos de ancho fijo
+struct AgregadosInstantanea {
+    uint64_t n;
+    uint64_t indiceMinimo;
+    uint64_t indiceMaximo;
+    double minimo;
+    double maximo;
+    double suma;
+    double compensacion;
+    double media;
+    double m2;
+
+    // O(1)
+    static AgregadosInstantanea desde(const Agregados& a) {
+        return {a.n, a.indiceMinimo, a.indiceMaximo, a.minimo, a.maximo, a.suma.suma, a.suma.compensacion,
+                a.momentos.media, a.momentos.m2};
+    }
+
+    // O(1)
+    Agregados comoAgregados() const {
+        Agregados a;
+        a.n = static_cast<size_t>(n);
+        a.indiceMinimo = static_cast<size_t>(indiceMinimo);
+        a.indiceMaximo = static_cast<size_t>(indiceMaximo);
+        a.minimo = minimo;
+        a.maximo = maximo;
+        a.suma = SumaCompensada{suma, compensacion};
+        a.momentos = MomentosWelford{media, m2};
+        return a;
+    }
+};
+
+struct EjeInstantanea {
+    uint64_t numTiempos;
+    uint64_t desplazamiento; // int64_t[numTiempos]
+};
+
+struct SensorInstantanea {
+    uint32_t tipo;                   // TipoSensorInstantanea
+    uint32_t modo;                   // ModoInstantanea
+    uint64_t desplazamientoId;
+    uint64_t longitudId;
+    uint64_t desplazamientoUnidad;
+    uint64_t longitudUnidad;
+    uint64_t numLecturas;
+    uint64_t eje;                    // índice en la tabla de ejes (SIN_EJE si comprimido)
+    uint64_t desplazamientoValores;  // double[numLecturas] (crudo y retención)
+    uint64_t puntosPorBloque;        // comprimido
+    uint64_t numBloques;
+    uint64_t desplazamientoBloques;  // BloqueInstantanea[numBloques]
+    uint64_t capacidadRetencion;     // retención
+    int64_t ventanaSegundos;
+    AgregadosInstantanea agregados;
+    uint64_t desplazamientoCuantiles;  // CuantilesInstantanea + uint64_t[numNiveles] + double[retenidos]
+    uint64_t numBordes;                // histograma
+    uint64_t desplazamientoHistograma; // double[numBordes] + uint64_t[numBordes + 1] (0 si no tiene)
+};
+
+// Bosquejo KLL: estado del generador y tamaño de cada nivel; los valores de
+// los niveles van a continuación, contiguos y empezando por el nivel 0
+struct CuantilesInstantanea {
+    uint64_t k;
+    uint64_t n;
+    double minimo;
+    double maximo;
+    uint64_t estado;
+    uint64_t numNiveles;
+};
+
+// Bloque comprimido: cabecera, estado del codificador y sus palabras de bits
+struct BloqueInstantanea {
+    int64_t tiempoInicial;
+    int64_t tiempoFinal;
+    AgregadosInstantanea agregados;
+    int64_t tiempoPrevio;
+    int64_t deltaPrevio;
+    uint64_t bitsPrevios;
+    uint32_t ceroIzqPrevio;
+    uint32_t ceroDerPrevio;
+    uint64_t bits;
+    uint64_t desplazamientoPalabras; // uint64_t[numPalabras]
+    uint64_t numPalabras;
+};
+
+static_assert(sizeof(CabeceraInstantanea) == 40, "cabecera con relleno inesperado");
+static_assert(sizeof(AgregadosInstantanea) == 72, "agregados con relleno inesperado");
+static_assert(sizeof(SensorInstantanea) == 200, "sensor con relleno inesperado");
+static_assert(sizeof(BloqueInstantanea) == 144, "bloque con relleno inesperado");
+static_assert(sizeof(CuantilesInstantanea) == 48, "cuantiles con relleno inesperado");
+
+// O(tamaño) - Llevar a disco el contenido de un archivo ya escrito y cerrado
+// (antes de publicarlo con rename: si no, un corte de energía puede dejar el
+// nombre apuntando a un archivo vacío o incompleto)
+inline bool sincronizarArchivo(const std::string& nombreArchivo) {
+#if defined(_WIN32)
+    HANDLE h = CreateFileA(nombreArchivo.c_str(), GENERIC_WRITE, FILE_SHARE_READ, nullptr,
+                           OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (h == INVALID_HANDLE_VALUE) return false;
+    bool ok = FlushFileBuffers(h) != 0;
+    CloseHandle(h);
+    return ok;
+#elif defined(__unix__) || defined(__APPLE__)
+    int fd = ::open(nombreArchivo.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    bool ok = ::fsync(fd) == 0;
+    ::close(fd);
+    return ok;
+#else
+    (void)nombreArchivo;
+    return false;
+#endif
+}
+
+// O(1) - Llevar a disco el directorio que contiene 'nombreArchivo', así el
+// rename que lo publicó sobrevive a un corte. En Windows no hay equivalente
+// (NTFS registra el cambio de nombre en su diario): no hace nada
+inline bool sincronizarDirectorio(const std::string& nombreArchivo) {
+#if defined(__unix__) || defined(__APPLE__)
+    size_t barra = nombreArchivo.find_last_of('/');
+    std::string directorio = barra == std::string::npos ? "." : nombreArchivo.substr(0, barra + 1);
+    int fd = ::open(directorio.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    bool ok = ::fsync(fd) == 0;
+    ::close(fd);
+    return ok;
+#else
+    (void)nombreArchivo;
+    return true;
+#endif
+}
+
+// InstantaneaMapeada - Vista de solo lectura sobre una instantánea mapeada
+// Al abrir se validan la cabecera, todos los desplazamientos y los índices de
+// los agregados, los invariantes de cada bosquejo y los bordes de cada
+// histograma, y se recorren los prefijos de cada flujo comprimido
+// (O(m + e + b) más O(n) por sensor comprimido); después las columnas se usan directamente desde el mapeo, y el SO solo lee
+// las páginas que se tocan. Los punteros viven mientras viva el objeto.
+class InstantaneaMapeada {
+private:
+    ArchivoMapeado archivo;
+    const CabeceraInstantanea* cabecera = nullptr;
+    const SensorInstantanea* sensores = nullptr;
+    const EjeInstantanea* ejes = nullptr;
+
+    const char* base() const { return archivo.contenido().data(); }
+
+    // O(1) - [desplazamiento, desplazamiento + bytes) cae dentro del archivo y alineado
+    bool rangoValido(uint64_t desplazamiento, uint64_t elementos, uint64_t tamElemento) const {
+        uint64_t tam = archivo.size();
+        if (desplazamiento % 8 != 0 || desplazamiento > tam) return false;
+        return elementos <= (tam - desplazamiento) / tamElemento;
+    }
+
+    // O(1) - Con lecturas, el mínimo y el máximo caen en [inicio, inicio + n)
+    static bool indicesValidos(const AgregadosInstantanea& a, uint64_t inicio, uint64_t n) {
+        if (a.n == 0) return true;
+        return a.indiceMinimo >= inicio && a.indiceMinimo - inicio < n &&
+               a.indiceMaximo >= inicio && a.indiceMaximo - inicio < n;
+    }
+
+    // O(H + r) - Bosquejo de cuantiles del sensor dentro del archivo y con sus invariantes
+    bool cuantilesValidos(const SensorInstantanea& si) const {
+        if (!rangoValido(si.desplazamientoCuantiles, 1, sizeof(CuantilesInstantanea))) return false;
+        const CuantilesInstantanea* c = reinterpret_cast<const CuantilesInstantanea*>(base() + si.desplazamientoCuantiles);
+        uint64_t posTamanos = si.desplazamientoCuantiles + sizeof(CuantilesInstantanea);
+        if (c->numNiveles == 0 || c->numNiveles > 64 || !rangoValido(posTamanos, c->numNiveles, sizeof(uint64_t))) return false;
+        const uint64_t* tamanos = reinterpret_cast<const uint64_t*>(base() + posTamanos);
+        uint64_t retenidos = 0;
+        for (uint64_t h = 0; h < c->numNiveles; h++) {
+            if (tamanos[h] > archivo.size()) return false; // la suma no desborda
+            retenidos += tamanos[h];
+        }
+        if (!rangoValido(posTamanos + c->numNiveles * sizeof(uint64_t), retenidos, sizeof(double))) return false;
+        return BosquejoKLL::nivelesValidos(static_cast<size_t>(c->k), c->n, tamanos, static_cast<size_t>(c->numNiveles),
+                                           reinterpret_cast<const double*>(tamanos + c->numNiveles));
+    }
+
+    // O(m) - Sin histograma, o bordes finitos y crecientes con sus conteos dentro del archivo
+    bool histogramaValido(const SensorInstantanea& si) const {
+        if (si.desplazamientoHistograma == 0) return si.numBordes == 0;
+        if (!rangoValido(si.desplazamientoHistograma, si.numBordes, sizeof(double))) return false;
+        if (!rangoValido(si.desplazamientoHistograma + si.numBordes * sizeof(double), si.numBordes + 1, sizeof(uint64_t))) {
+            return false;
+        }
+        const double* bordes = reinterpret_cast<const double*>(base() + si.desplazamientoHistograma);
+        return Histograma::bordesValidos(std::vector<double>(bordes, bordes + si.numBordes));
+    }
+
+    bool validar() {
+        if (!archivo.valido() || archivo.size() < sizeof(CabeceraInstantanea)) return false;
+        const CabeceraInstantanea* c = reinterpret_cast<const CabeceraInstantanea*>(base());
+        if (std::memcmp(c->magia, MAGIA_INSTANTANEA, 8) != 0) return false;
+        if (c->version != VERSION_INSTANTANEA || c->marcaOrden != MARCA_ORDEN_BYTES) return false;
+        if (c->tamanoArchivo != archivo.size()) return false; // escritura truncada
+
+        uint64_t pos = sizeof(CabeceraInstantanea);
+        if (!rangoValido(pos, c->numSensores, sizeof(SensorInstantanea))) return false;
+        const SensorInstantanea* s = reinterpret_cast<const SensorInstantanea*>(base() + pos);
+        pos += c->numSensores * sizeof(SensorInstantanea);
+        if (!rangoValido(pos, c->numEjes, sizeof(EjeInstantanea))) return false;
+        const EjeInstantanea* e = reinterpret_cast<const EjeInstantanea*>(base() + pos);
+
+        for (uint64_t k = 0; k < c->numEjes; k++) {
+            if (!rangoValido(e[k].desplazamiento, e[k].numTiempos, sizeof(int64_t))) return false;
+        }
+        for (uint64_t k = 0; k < c->numSensores; k++) {
+            const SensorInstantanea& si = s[k];
+            if (!rangoValido(si.desplazamientoId, si.longitudId, 1)) return false;
+            if (!rangoValido(si.desplazamientoUnidad, si.longitudUnidad, 1)) return false;
+            if (si.agregados.n != si.numLecturas) return false;
+            if (!indicesValidos(si.agregados, 0, si.numLecturas)) return false;
+            if (!cuantilesValidos(si) || !histogramaValido(si)) return false;
+            if (si.modo == MODO_COMPRIMIDO) {
+                if (si.puntosPorBloque == 0) return false;
+                if (!rangoValido(si.desplazamientoBloques, si.numBloques, sizeof(BloqueInstantanea))) return false;
+                const BloqueInstantanea* b = reinterpret_cast<const BloqueInstantanea*>(base() + si.desplazamientoBloques);
+                uint64_t puntos = 0;
+                for (uint64_t j = 0; j < si.numBloques; j++) {
+                    if (!rangoValido(b[j].desplazamientoPalabras, b[j].numPalabras, sizeof(uint64_t))) return false;
+                    if (b[j].bits > b[j].numPalabras * 64) return false;
+                    // punto(i) ubica el bloque con i / puntosPorBloque: solo el último puede ir incompleto
+                    if (b[j].agregados.n == 0 || b[j].agregados.n > si.puntosPorBloque) return false;
+                    if (j + 1 < si.numBloques && b[j].agregados.n != si.puntosPorBloque) return false;
+                    // Índices absolutos: los del bloque j empiezan tras los puntos de los anteriores
+                    if (!indicesValidos(b[j].agregados, puntos, b[j].agregados.n)) return false;
+                    if (!SerieComprimida::flujoValido(reinterpret_cast<const uint64_t*>(base() + b[j].desplazamientoPalabras),
+                                                      static_cast<size_t>(b[j].bits), static_cast<size_t>(b[j].agregados.n))) {
+                        return false;
+                    }
+                    puntos += b[j].agregados.n;
+                }
+                if (puntos != si.numLecturas) return false;
+            } else if (si.modo == MODO_CRUDO || si.modo == MODO_RETENCION) {
+                if (si.eje >= c->numEjes || e[si.eje].numTiempos < si.numLecturas) return false;
+                if (!rangoValido(si.desplazamientoValores, si.numLecturas, sizeof(double))) return false;
+                if (si.modo == MODO_RETENCION && si.capacidadRetencion == 0) return false;
+            } else {
+                return false;
+            }
+        }
+        cabecera = c;
+        sensores = s;
+        ejes = e;
+        return true;
+    }
+
+public:
+    explicit InstantaneaMapeada(const std::string& nombreArchivo) : archivo(nombreArchivo) {
+        validar();
+    }
+
+    bool valida() const { return cabecera != nullptr; } // O(1)
+
+    size_t numSensores() const { return cabecera ? static_cast<size_t>(cabecera->numSensores) : 0; } // O(1)
+    size_t numEjes() const { return cabecera ? static_cast<size_t>(cabecera->numEjes) : 0; }         // O(1)
+
+    const SensorInstantanea& sensor(size_t i) const { return sensores[i]; } // O(1)
+    const EjeInstantanea& eje(size_t e) const { return ejes[e]; }          // O(1)
+
+    // O(1) - Campos del sensor i como vistas sobre el mapeo
+    std::string_view id(size_t i) const {
+        return std::string_view(base() + sensores[i].desplazamientoId, sensores[i].longitudId);
+    }
+    std::string_view unidad(size_t i) const {
+        return std::string_view(base() + sensores[i].desplazamientoUnidad, sensores[i].longitudUnidad);
+    }
+    Agregados agregados(size_t i) const { return sensores[i].agregados.comoAgregados(); }
+
+    // O(1) - Columnas sin copiar (crudo y retención); 'numLecturas' elementos
+    const double* valores(size_t i) const {
+        return reinterpret_cast<const double*>(base() + sensores[i].desplazamientoValores);
+    }
+    const int64_t* tiemposEje(size_t e) const {
+        return reinterpret_cast<const int64_t*>(base() + ejes[e].desplazamiento);
+    }
+
+    // O(1) - Bloques comprimidos del sensor i y palabras de cada bloque
+    const BloqueInstantanea* bloques(size_t i) const {
+        return reinterpret_cast<const BloqueInstantanea*>(base() + sensores[i].desplazamientoBloques);
+    }
+    const uint64_t* palabras(const BloqueInstantanea& b) const {
+        return reinterpret_cast<const uint64_t*>(base() + b.desplazamientoPalabras);
+    }
+
+    // O(H + r) - Bosquejo de cuantiles guardado del sensor i
+    BosquejoKLL cuantiles(size_t i) const {
+        const CuantilesInstantanea* c = reinterpret_cast<const CuantilesInstantanea*>(base() + sensores[i].desplazamientoCuantiles);
+        const uint64_t* tamanos = reinterpret_cast<const uint64_t*>(c + 1);
+        return BosquejoKLL::desdeNiveles(static_cast<size_t>(c->k), c->n, c->minimo, c->maximo, c->estado, tamanos,
+                                         static_cast<size_t>(c->numNiveles),
+                                         reinterpret_cast<const double*>(tamanos + c->numNiveles));
+    }
+
+    // O(1) - Histograma del sensor i (si tieneHistograma): bordes y numBordes + 1 conteos totales
+    bool tieneHistograma(size_t i) const { return sensores[i].desplazamientoHistograma != 0; }
+    const double* bordesHistograma(size_t i) const {
+        return reinterpret_cast<const double*>(base() + sensores[i].desplazamientoHistograma);
+    }
+    const uint64_t* conteosHistograma(size_t i) const {
+        return reinterpret_cast<const uint64_t*>(bordesHistograma(i) + sensores[i].numBordes);
+    }
+
+    // O(m) - Posición del sensor con ese id (numSensores() si no existe)
+    size_t buscarSensor(std::string_view idBuscado) const {
+        for (size_t i = 0; i < numSensores(); i++) if (id(i) == idBuscado) return i;
+        return numSensores();
+    }
+};
+
+#endif
@@ -0,0 +1,173 @@
+#ifndef KERNELESTADISTICAS_H
+#define KERNELESTADISTICAS_H
+
+#include <cstddef>
+#include <cmath>
+#include "Estadisticas.h"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    #include <immintrin.h>
+    #define KERNEL_AVX2_DISPONIBLE 1
+#endif
+
+// Kernel de estadísticas en una sola pasada sobre un tramo contiguo de lecturas:
+// mínimo, máximo (con su índice), suma compensada, suma de cuadrados y los
+// momentos de Welford (media y m2, para la varianza).
+// La versión AVX2 se elige en tiempo de ejecución si el procesador la soporta;
+// en otro caso (u otros compiladores/arquitecturas) se usa la versión escalar.
+
+// Resultado del kernel (los índices son relativos al inicio del tramo)
+struct ResumenEstadistico {
+    size_t n = 0;
+    double minimo = 0.0;
+    double maximo = 0.0;
+    size_t indiceMinimo = 0;
+    size_t indiceMaximo = 0;
+    SumaCompensada suma;
+    double sumaCuadrados = 0.0;
+    MomentosWelford momentos;
+
+    // O(1) - Convertir a Agregados con índices absolutos (tramo que empieza en 'base')
+    Agregados comoAgregados(size_t base) const {
+        Agregados a;
+        a.n = n;
+        a.minimo = minimo;
+        a.maximo = maximo;
+        a.indiceMinimo = base + indiceMinimo;
+        a.indiceMaximo = base + indiceMaximo;
+        a.suma = suma;
+        a.momentos = momentos;
+        return a;
+    }
+
+    // O(1) - Incorporar el resumen de un tramo posterior que empieza en 'base'
+    // (índices de 'otro' relativos a su tramo); los empates conservan el anterior
+    void combinar(const ResumenEstadistico& otro, size_t base) {
+        if (otro.n == 0) return;
+        if (n == 0 || otro.minimo < minimo) { minimo = otro.minimo; indiceMinimo = base + otro.indiceMinimo; }
+        if (n == 0 || otro.maximo > maximo) { maximo = otro.maximo; indiceMaximo = base + otro.indiceMaximo; }
+        suma.combinar(otro.suma);
+        sumaCuadrados += otro.sumaCuadrados;
+        momentos.combinar(n, otro.momentos, otro.n);
+        n += otro.n;
+    }
+};
+
+// O(n) - Versión escalar de referencia
+inline ResumenEstadistico calcularEstadisticasEscalar(const double* datos, size_t n) {
+    ResumenEstadistico r;
+    r.n = n;
+    if (n == 0) return r;
+    r.minimo = r.maximo = datos[0];
+    for (size_t i = 0; i < n; i++) {
+        double v = datos[i];
+        if (v < r.minimo) { r.minimo = v; r.indiceMinimo = i; }
+        if (v > r.maximo) { r.maximo = v; r.indiceMaximo = i; }
+        r.suma.agregar(v);
+        r.sumaCuadrados += v * v;
+        r.momentos.agregar(v, i + 1);
+    }
+    return r;
+}
+
+#ifdef KERNEL_AVX2_DISPONIBLE
+// O(n / 4) - Cuatro carriles independientes; cada carril conserva la primera
+// aparición de su mínimo/máximo y al final se reduce por valor y luego por índice.
+// La suma de Neumaier también se hace por carril con máscaras en vez de ramas,
+// y Welford por carril (todos llevan el mismo conteo); los carriles se combinan
+// al final con la fórmula de Chan.
+__attribute__((target("avx2")))
+inline ResumenEstadistico calcularEstadisticasAVX2(const double* datos, size_t n) {
+    if (n < 8) return calcularEstadisticasEscalar(datos, n);
+
+    const __m256d sinSigno = _mm256_castsi256_pd(_mm256_set1_epi64x(0x7FFFFFFFFFFFFFFFLL));
+    __m256d vmin = _mm256_loadu_pd(datos);
+    __m256d vmax = vmin;
+    __m256i imin = _mm256_set_epi64x(3, 2, 1, 0);
+    __m256i imax = imin;
+    __m256i idx = imin;
+    const __m256i paso = _mm256_set1_epi64x(4);
+    __m256d suma = _mm256_setzero_pd();
+    __m256d comp = _mm256_setzero_pd();
+    __m256d cuad = _mm256_setzero_pd();
+    __m256d media = _mm256_setzero_pd();
+    __m256d m2 = _mm256_setzero_pd();
+
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d v = _mm256_loadu_pd(datos + i);
+
+        __m256d menor = _mm256_cmp_pd(v, vmin, _CMP_LT_OQ);
+        vmin = _mm256_blendv_pd(vmin, v, menor);
+        imin = _mm256_castpd_si256(_mm256_blendv_pd(_mm256_castsi256_pd(imin), _mm256_castsi256_pd(idx), menor));
+        __m256d mayor = _mm256_cmp_pd(v, vmax, _CMP_GT_OQ);
+        vmax = _mm256_blendv_pd(vmax, v, mayor);
+        imax = _mm256_castpd_si256(_mm256_blendv_pd(_mm256_castsi256_pd(imax), _mm256_castsi256_pd(idx), mayor));
+        idx = _mm256_add_epi64(idx, paso);
+
+        // Neumaier por carril: elegir el término de error según |suma| >= |v|
+        __m256d t = _mm256_add_pd(suma, v);
+        __m256d sumaMayor = _mm256_cmp_pd(_mm256_and_pd(suma, sinSigno), _mm256_and_pd(v, sinSigno), _CMP_GE_OQ);
+        __m256d errA = _mm256_add_pd(_mm256_sub_pd(suma, t), v);
+        __m256d errB = _mm256_add_pd(_mm256_sub_pd(v, t), suma);
+        comp = _mm256_add_pd(comp, _mm256_blendv_pd(errB, errA, sumaMayor));
+        suma = t;
+
+        cuad = _mm256_add_pd(cuad, _mm256_mul_pd(v, v));
+
+        __m256d delta = _mm256_sub_pd(v, media);
+        media = _mm256_add_pd(media, _mm256_mul_pd(delta, _mm256_set1_pd(1.0 / static_cast<double>(i / 4 + 1))));
+        m2 = _mm256_add_pd(m2, _mm256_mul_pd(delta, _mm256_sub_pd(v, media)));
+    }
+
+    alignas(32) double mins[4], maxs[4], sumas[4], comps[4], cuads[4], medias[4], m2s[4];
+    alignas(32) long long imins[4], imaxs[4];
+    _mm256_store_pd(mins, vmin);
+    _mm256_store_pd(maxs, vmax);
+    _mm256_store_pd(sumas, suma);
+    _mm256_store_pd(comps, comp);
+    _mm256_store_pd(cuads, cuad);
+    _mm256_store_pd(medias, media);
+    _mm256_store_pd(m2s, m2);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(imins), imin);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(imaxs), imax);
+
+    ResumenEstadistico r;
+    r.n = n;
+    r.minimo = mins[0]; r.indiceMinimo = static_cast<size_t>(imins[0]);
+    r.maximo = maxs[0]; r.indiceMaximo = static_cast<size_t>(imaxs[0]);
+    for (int c = 1; c < 4; c++) {
+        size_t im = static_cast<size_t>(imins[c]), iM = static_cast<size_t>(imaxs[c]);
+        if (mins[c] < r.minimo || (mins[c] == r.minimo && im < r.indiceMinimo)) { r.minimo = mins[c]; r.indiceMinimo = im; }
+        if (maxs[c] > r.maximo || (maxs[c] == r.maximo && iM < r.indiceMaximo)) { r.maximo = maxs[c]; r.indiceMaximo = iM; }
+    }
+    size_t porCarril = i / 4;
+    for (int c = 0; c < 4; c++) {
+        r.suma.combinar(SumaCompensada{sumas[c], comps[c]});
+        r.sumaCuadrados += cuads[c];
+        r.momentos.combinar(porCarril * c, MomentosWelford{medias[c], m2s[c]}, porCarril);
+    }
+
+    // Cola de menos de 4 elementos
+    for (; i < n; i++) {
+        double v = datos[i];
+        if (v < r.minimo) { r.minimo = v; r.indiceMinimo = i; }
+        if (v > r.maximo) { r.maximo = v; r.indiceMaximo = i; }
+        r.suma.agregar(v);
+        r.sumaCuadrados += v * v;
+        r.momentos.agregar(v, i + 1);
+    }
+    return r;
+}
+#endif
+
+// O(n) - Punto de entrada: detecta AVX2 una sola vez y despacha
+inline ResumenEstadistico calcularEstadisticas(const double* datos, size_t n) {
+#ifdef KERNEL_AVX2_DISPONIBLE
+    static const bool tieneAVX2 = __builtin_cpu_supports("avx2");
+    if (tieneAVX2) return calcularEstadisticasAVX2(datos, n);
+#endif
+    return calcularEstadisticasEscalar(datos, n);
+}
+
+#endif
@@ -0,0 +1,161 @@
+#ifndef ORDENAMIENTORADIX_H
+#define ORDENAMIENTORADIX_H
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+#include <thread>
+#include <algorithm>
+
+// Ordenamiento radix LSD de lecturas double con su índice
+// Cada double se convierte en una clave entera de 64 bits que conserva el orden
+// (truco del signo: a los positivos se les enciende el bit de signo y a los
+// negativos se les invierten todos los bits), así se ordena por dígitos sin
+// comparar doubles. Seis pasadas de 11 bits; como los histogramas de todos los
+// dígitos se cuentan en la primera lectura, se omiten las pasadas en que todas
+// las claves comparten el dígito (habitual en los bits altos de un mismo rango
+// de temperaturas). Es estable: ante valores iguales se conserva el orden de
+// entrada. -0.0 se trata como 0.0 (y se devuelve como 0.0).
+
+// Par a ordenar por valor; el índice acompaña (p. ej. la posición de la lectura)
+struct ParValorIndice {
+    double valor;
+    uint32_t indice;
+};
+
+constexpr unsigned BITS_DIGITO_RADIX = 11;
+constexpr size_t CUBETAS_RADIX = size_t(1) << BITS_DIGITO_RADIX;
+constexpr unsigned PASADAS_RADIX = (64 + BITS_DIGITO_RADIX - 1) / BITS_DIGITO_RADIX;
+constexpr uint64_t BIT_SIGNO = uint64_t(1) << 63;
+
+// Elemento interno: clave ordenable + índice
+struct ElementoRadix {
+    uint64_t clave;
+    uint32_t indice;
+};
+
+// O(1) - Clave entera con el mismo orden que el double
+inline uint64_t claveRadix(double v) {
+    if (v == 0.0) v = 0.0; // -0.0 == 0.0
+    uint64_t bits;
+    std::memcpy(&bits, &v, sizeof(bits));
+    return (bits & BIT_SIGNO) ? ~bits : (bits | BIT_SIGNO);
+}
+
+// O(1) - Inversa de claveRadix
+inline double valorDeClaveRadix(uint64_t clave) {
+    uint64_t bits = (clave & BIT_SIGNO) ? (clave & ~BIT_SIGNO) : ~clave;
+    double v;
+    std::memcpy(&v, &bits, sizeof(v));
+    return v;
+}
+
+// O(1) - Dígito p (de 11 bits) de una clave
+inline size_t digitoRadix(uint64_t clave, unsigned p) {
+    return static_cast<size_t>((clave >> (p * BITS_DIGITO_RADIX)) & (CUBETAS_RADIX - 1));
+}
+
+// O(n) - Versión secuencial
+inline void ordenarRadix(ParValorIndice* datos, size_t n) {
+    if (n < 2) return;
+    std::vector<ElementoRadix> a(n), b(n);
+    std::vector<size_t> histogramas(PASADAS_RADIX * CUBETAS_RADIX, 0);
+    for (size_t i = 0; i < n; i++) {
+        uint64_t clave = claveRadix(datos[i].valor);
+        a[i] = {clave, datos[i].indice};
+        for (unsigned p = 0; p < PASADAS_RADIX; p++) histogramas[p * CUBETAS_RADIX + digitoRadix(clave, p)]++;
+    }
+
+    ElementoRadix* origen = a.data();
+    ElementoRadix* destino = b.data();
+    for (unsigned p = 0; p < PASADAS_RADIX; p++) {
+        size_t* h = &histogramas[p * CUBETAS_RADIX];
+        if (h[digitoRadix(origen[0].clave, p)] == n) continue; // todas comparten el dígito
+        size_t acumulado = 0;
+        for (size_t d = 0; d < CUBETAS_RADIX; d++) {
+            size_t cuantos = h[d];
+            h[d] = acumulado;
+            acumulado += cuantos;
+        }
+        for (size_t i = 0; i < n; i++) destino[h[digitoRadix(origen[i].clave, p)]++] = origen[i];
+        std::swap(origen, destino);
+    }
+
+    for (size_t i = 0; i < n; i++) datos[i] = {valorDeClaveRadix(origen[i].clave), origen[i].indice};
+}
+
+// O(n / h) por hilo - Ejecutar f(t) para t = 0..hilos-1 (el 0 en el hilo que llama)
+template <typename F>
+inline void enParaleloRadix(unsigned hilos, F f) {
+    std::vector<std::thread> trabajadores;
+    for (unsigned t = 1; t < hilos; t++) trabajadores.emplace_back(f, t);
+    f(0u);
+    for (auto& t : trabajadores) t.join();
+}
+
+// O(n / h + 2048 h) por pasada - Versión paralela para series grandes
+// Cada hilo cuenta y reparte su propio trozo; los desplazamientos se asignan
+// por (dígito, hilo) en ese orden, así el resultado es idéntico al secuencial.
+// Con un solo hilo o pocas lecturas usa la versión secuencial.
+inline void ordenarRadixParalelo(ParValorIndice* datos, size_t n, unsigned hilos = 0) {
+    if (hilos == 0) hilos = std::max(1u, std::thread::hardware_concurrency());
+    if (hilos == 1 || n < (size_t(1) << 16) * hilos) {
+        ordenarRadix(datos, n);
+        return;
+    }
+    std::vector<ElementoRadix> a(n), b(n);
+    auto inicioTrozo = [&](unsigned t) { return n / hilos * t + std::min<size_t>(t, n % hilos); };
+
+    // Claves e histogramas de todos los dígitos por hilo (para saber qué pasadas omitir)
+    std::vector<size_t> totales(hilos * PASADAS_RADIX * CUBETAS_RADIX, 0);
+    enParaleloRadix(hilos, [&](unsigned t) {
+        size_t* h = &totales[t * PASADAS_RADIX * CUBETAS_RADIX];
+        for (size_t i = inicioTrozo(t); i < inicioTrozo(t + 1); i++) {
+            uint64_t clave = claveRadix(datos[i].valor);
+            a[i] = {clave, datos[i].indice};
+            for (unsigned p = 0; p < PASADAS_RADIX; p++) h[p * CUBETAS_RADIX + digitoRadix(clave, p)]++;
+        }
+    });
+
+    ElementoRadix* origen = a.data();
+    ElementoRadix* destino = b.data();
+    std::vector<size_t> desplazamientos(hilos * CUBETAS_RADIX);
+    for (unsigned p = 0; p < PASADAS_RADIX; p++) {
+        size_t digitoPrimero = digitoRadix(origen[0].clave, p), conDigitoPrimero = 0;
+        for (unsigned t = 0; t < hilos; t++) {
+            conDigitoPrimero += totales[(t * PASADAS_RADIX + p) * CUBETAS_RADIX + digitoPrimero];
+        }
+        if (conDigitoPrimero == n) continue;
+
+        // Histogramas del dígito p por trozo del arreglo actual
+        enParaleloRadix(hilos, [&](unsigned t) {
+            size_t* h = &desplazamientos[t * CUBETAS_RADIX];
+            std::fill(h, h + CUBETAS_RADIX, 0);
+            for (size_t i = inicioTrozo(t); i < inicioTrozo(t + 1); i++) h[digitoRadix(origen[i].clave, p)]++;
+        });
+        size_t acumulado = 0;
+        for (size_t d = 0; d < CUBETAS_RADIX; d++) {
+            for (unsigned t = 0; t < hilos; t++) {
+                size_t cuantos = desplazamientos[t * CUBETAS_RADIX + d];
+                desplazamientos[t * CUBETAS_RADIX + d] = acumulado;
+                acumulado += cuantos;
+            }
+        }
+        enParaleloRadix(hilos, [&](unsigned t) {
+            size_t* h = &desplazamientos[t * CUBETAS_RADIX];
+            for (size_t i = inicioTrozo(t); i < inicioTrozo(t + 1); i++) {
+                destino[h[digitoRadix(origen[i].clave, p)]++] = origen[i];
+            }
+        });
+        std::swap(origen, destino);
+    }
+
+    enParaleloRadix(hilos, [&](unsigned t) {
+        for (size_t i = inicioTrozo(t); i < inicioTrozo(t + 1); i++) {
+            datos[i] = {valorDeClaveRadix(origen[i].clave), origen[i].indice};
+        }
+    });
+}
+
+#endif
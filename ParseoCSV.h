@@ -0,0 +1,194 @@
+#ifndef PARSEOCSV_H
+#define PARSEOCSV_H
+
+#include <string_view>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <charconv>
+#include <system_error>
+#include <cerrno>
+#include <vector>
+#include <algorithm>
+#include "EscanerCSV.h"
+#include "Tiempo.h"
+
+// Utilidades de parseo sobre std::string_view - ninguna reserva memoria en el heap
+
+// O(1) - Quitar el '\r' final de archivos con fin de línea de Windows
+inline std::string_view quitarRetornoCarro(std::string_view linea) {
+    if (!linea.empty() && linea.back() == '\r') linea.remove_suffix(1);
+    return linea;
+}
+
+// O(k) - Respaldo general: copia el campo a un buffer en la pila porque
+// strtod requiere una cadena terminada en '\0' y la vista apunta al archivo.
+// Como std::stod: admite espacios alrededor y rechaza campos vacíos, no
+// numéricos, con basura después del número o fuera del rango de double.
+inline bool parsearDoubleLento(std::string_view campo, double& valor) {
+    char buffer[64];
+    if (campo.size() >= sizeof(buffer)) return false;
+    std::memcpy(buffer, campo.data(), campo.size());
+    buffer[campo.size()] = '\0';
+    char* fin = nullptr;
+    errno = 0;
+    double leido = std::strtod(buffer, &fin);
+    if (fin == buffer || errno == ERANGE) return false;
+    while (*fin == ' ' || *fin == '\t') ++fin;
+    if (*fin != '\0') return false;
+    valor = leido;
+    return true;
+}
+
+// O(k) - Convierte un campo numérico directamente desde el buffer de entrada.
+// Ruta rápida en punto fijo para los valores "dd.d" que emiten los sensores:
+// la mantisa entera (< 2^53) y 10^d son exactos en double, así que una sola
+// división da el mismo resultado correctamente redondeado que std::stod.
+// Otros formatos (exponente, más de 15 dígitos, espacios) usan std::from_chars
+// o, si no está disponible, strtod. Ninguna ruta depende del locale salvo strtod.
+// Retorna false (sin tocar 'valor') si el campo no es un número: vacío, texto o
+// con caracteres sobrantes. Los cargadores descartan esa fila completa.
+inline bool parsearDouble(std::string_view campo, double& valor) {
+    static constexpr double potencias10[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+        1e11, 1e12, 1e13, 1e14, 1e15
+    };
+
+    const char* p = campo.data();
+    const char* fin = p + campo.size();
+    bool negativo = false;
+    if (p != fin && (*p == '-' || *p == '+')) negativo = (*p++ == '-');
+
+    uint64_t mantisa = 0;
+    int digitos = 0;
+    int decimales = 0;
+    const char* inicioDigitos = p;
+    for (; p != fin && static_cast<unsigned>(*p - '0') < 10; ++p, ++digitos) {
+        mantisa = mantisa * 10 + static_cast<unsigned>(*p - '0');
+    }
+    bool hayDigitos = p != inicioDigitos;
+    if (p != fin && *p == '.') {
+        const char* inicioDecimales = ++p;
+        for (; p != fin && static_cast<unsigned>(*p - '0') < 10; ++p, ++digitos) {
+            mantisa = mantisa * 10 + static_cast<unsigned>(*p - '0');
+        }
+        decimales = static_cast<int>(p - inicioDecimales);
+        hayDigitos = hayDigitos || decimales > 0;
+    }
+
+    if (p == fin && hayDigitos && digitos <= 15) {
+        double absoluto = static_cast<double>(mantisa) / potencias10[decimales];
+        valor = negativo ? -absoluto : absoluto;
+        return true;
+    }
+
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    const char* inicio = campo.data();
+    if (!campo.empty() && campo.front() == '+') ++inicio; // from_chars no acepta '+'
+    double leido;
+    auto res = std::from_chars(inicio, campo.data() + campo.size(), leido);
+    if (res.ec == std::errc() && res.ptr == campo.data() + campo.size()) {
+        valor = leido;
+        return true;
+    }
+#endif
+    return parsearDoubleLento(campo, valor);
+}
+
+// O(k) - Posición del primer byte de datos después del encabezado
+inline size_t saltarEncabezado(std::string_view datos) {
+    size_t fin = datos.find('\n');
+    return fin == std::string_view::npos ? datos.size() : fin + 1;
+}
+
+// O(l) - Recorre las filas de un bloque y llama a porFila(campos) con los
+// campos de cada línea no vacía. Usa el escáner estructural vectorizado por
+// ventanas: cada ventana se indexa de una vez (todas sus ',' y '\n') y los
+// campos se cortan sobre ese índice, sin volver a buscar delimitadores.
+template <typename PorFila>
+void recorrerFilas(std::string_view bloque, PorFila&& porFila) {
+    size_t ventana = size_t(1) << 16;
+    std::vector<uint32_t> posiciones;
+    std::vector<std::string_view> campos;
+    size_t base = 0;
+
+    while (base < bloque.size()) {
+        size_t largo = std::min(ventana, bloque.size() - base);
+        bool ultima = base + largo == bloque.size();
+        if (posiciones.size() < largo) posiciones.resize(largo);
+        size_t total = indexarEstructura(bloque.data() + base, largo, posiciones.data());
+        std::string_view vista = bloque.substr(base, largo);
+
+        size_t inicioFila = 0;
+        size_t inicioCampo = 0;
+        campos.clear();
+        auto emitir = [&](size_t finFila) {
+            campos.push_back(quitarRetornoCarro(vista.substr(inicioCampo, finFila - inicioCampo)));
+            if (finFila > inicioFila) porFila(campos);
+            inicioFila = inicioCampo = finFila + 1;
+            campos.clear();
+        };
+
+        for (size_t k = 0; k < total; k++) {
+            size_t pos = posiciones[k];
+            if (vista[pos] == '\n') {
+                emitir(pos);
+            } else {
+                campos.push_back(vista.substr(inicioCampo, pos - inicioCampo));
+                inicioCampo = pos + 1;
+            }
+        }
+
+        if (ultima) {
+            if (inicioFila < largo) emitir(largo); // última fila sin '\n'
+            break;
+        }
+        if (inicioFila == 0) {
+            ventana *= 2; // Fila más larga que la ventana: reintentar con el doble
+            continue;
+        }
+        base += inicioFila; // La fila incompleta se reescanea en la siguiente ventana
+    }
+}
+
+// Plan de columnas resuelto una vez a partir del encabezado
+struct PlanColumnas {
+    size_t columnaFecha = 0;
+    std::vector<size_t> columnasValor; // una por canal enlazado, en orden de canal
+    size_t camposMinimos = 0;          // filas con menos campos se ignoran
+};
+
+// Columnas parseadas de un bloque del CSV (búfer por hilo del cargador paralelo)
+// Las fechas se convierten a segundos desde la época dentro de cada hilo.
+struct ColumnasCSV {
+    std::vector<int64_t> fechas;
+    std::vector<std::vector<double>> valores; // valores[c] = columna del canal c
+};
+
+// O(c) - Fecha y valores (uno por canal, en 'valores') de una fila según el plan
+// Retorna false si hay que descartar la fila: le faltan campos, o la fecha o
+// alguno de los valores no se pueden parsear. Todos los cargadores descartan
+// las mismas filas, así el eje compartido y las columnas quedan alineados.
+inline bool parsearFila(const std::vector<std::string_view>& campos, const PlanColumnas& plan,
+                        int64_t& fecha, double* valores) {
+    if (campos.size() < plan.camposMinimos) return false; // línea vacía o incompleta
+    if (!parsearFechaHora(campos[plan.columnaFecha], fecha)) return false;
+    for (size_t c = 0; c < plan.columnasValor.size(); c++) {
+        if (!parsearDouble(campos[plan.columnasValor[c]], valores[c])) return false;
+    }
+    return true;
+}
+
+// O(l) - Parsear un bloque completo a columnas según el plan
+inline void parsearBloque(std::string_view bloque, const PlanColumnas& plan, ColumnasCSV& columnas) {
+    columnas.valores.assign(plan.columnasValor.size(), {});
+    std::vector<double> fila(plan.columnasValor.size());
+    recorrerFilas(bloque, [&](const std::vector<std::string_view>& campos) {
+        int64_t segundos;
+        if (!parsearFila(campos, plan, segundos, fila.data())) return;
+        columnas.fechas.push_back(segundos);
+        for (size_t c = 0; c < fila.size(); c++) columnas.valores[c].push_back(fila[c]);
+    });
+}
+
+#endif
@@ -0,0 +1,534 @@
+#ifndef REGISTROESCRITURAANTICIPADA_H
+#define REGISTROESCRITURAANTICIPADA_H
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <algorithm>
+#include <unordered_map>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <atomic>
+#include "ArchivoMapeado.h"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    #include <immintrin.h>
+    #define CRC32C_HARDWARE_DISPONIBLE 1
+#endif
+
+#if defined(_WIN32)
+    #ifndef NOMINMAX
+    #define NOMINMAX
+    #endif
+    #include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <cerrno>
+#endif
+
+// Registro de escritura anticipada (WAL) para la ingesta incremental
+//
+//   [MAGIA_REGISTRO (8 bytes)] { [longitud u32][crc32c u32] { [tipo u8][carga] }* }*
+//
+// Cada lectura se anota antes de aplicarse al sensor. Las entradas se
+// acumulan en un lote en memoria y un hilo escritor vuelca cada lote como una
+// trama (longitud + CRC-32C) con una sola escritura + fsync (confirmación en
+// grupo): mientras un lote se sincroniza, la ingesta sigue llenando el
+// siguiente, y el CRC se calcula en el hilo escritor. La ingesta entrega el
+// lote al llenarse; si deja de llegar tráfico, el escritor lo toma él mismo
+// al cumplirse el intervalo. Las cargas masivas se anotan como una entrada
+// columnar por canal (tiempos y valores contiguos). Al reabrir, el archivo
+// se reproduce hasta la última trama íntegra; una trama cortada por una caída
+// nunca llegó a confirmarse y se descarta completa, y una trama con CRC válido
+// pero mal formada tampoco se aplica a medias.
+// El costo sobre la ingesta se mide con benchmarks/bench_registro.cpp.
+
+constexpr char MAGIA_REGISTRO[8] = {'S', 'E', 'N', 'S', 'W', 'A', 'L', '1'};
+
+enum TipoEntradaRegistro : uint8_t {
+    ENTRADA_DECLARACION = 1, // canal, tipo de sensor, id, unidad
+    ENTRADA_LECTURA = 2,     // canal, tiempo, valor
+    ENTRADA_LECTURAS = 3     // canal, k, tiempos[k], valores[k]
+};
+
+// O(n) - CRC-32C (Castagnoli, polinomio reflejado 0x82F63B78) con tabla
+inline uint32_t crc32cEscalar(const char* datos, size_t n, uint32_t crc = 0) {
+    static const auto tabla = [] {
+        std::vector<uint32_t> t(256);
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; k++) c = (c & 1) ? 0x82F63B78u ^ (c >> 1) : c >> 1;
+            t[i] = c;
+        }
+        return t;
+    }();
+    crc = ~crc;
+    for (size_t i = 0; i < n; i++) crc = tabla[(crc ^ static_cast<uint8_t>(datos[i])) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+#ifdef CRC32C_HARDWARE_DISPONIBLE
+// O(n / 8) - Instrucción crc32 de SSE4.2, 8 bytes por paso
+__attribute__((target("sse4.2")))
+inline uint32_t crc32cSSE42(const char* datos, size_t n, uint32_t crc = 0) {
+    crc = ~crc;
+    size_t i = 0;
+#if defined(__x86_64__)
+    uint64_t c = crc;
+    for (; i + 8 <= n; i += 8) {
+        uint64_t palabra;
+        std::memcpy(&palabra, datos + i, 8);
+        c = _mm_crc32_u64(c, palabra);
+    }
+    crc = static_cast<uint32_t>(c);
+#endif
+    for (; i < n; i++) crc = _mm_crc32_u8(crc, static_cast<uint8_t>(datos[i]));
+    return ~crc;
+}
+#endif
+
+// O(n) - Punto de entrada: detecta SSE4.2 una sola vez y despacha
+inline uint32_t crc32c(const char* datos, size_t n) {
+#ifdef CRC32C_HARDWARE_DISPONIBLE
+    static const bool tieneSSE42 = __builtin_cpu_supports("sse4.2");
+    if (tieneSSE42) return crc32cSSE42(datos, n);
+#endif
+    return crc32cEscalar(datos, n);
+}
+
+// Cada cuánto se confirma un lote en disco
+struct ConfiguracionRegistro {
+    size_t lecturasPorLote = 4096;                  // entregar el lote al llegar a este tamaño
+    std::chrono::milliseconds intervalo{50};        // o cuando el lote abierto tenga esta edad (aunque no lleguen más lecturas)
+    bool sincronizar = true;                        // fsync tras cada lote (false: solo write)
+};
+
+class RegistroEscrituraAnticipada {
+private:
+    static constexpr size_t BYTES_TRAMA = 8;              // longitud + CRC
+    static constexpr size_t BYTES_LECTURA = 1 + 4 + 8 + 8; // tipo + canal + tiempo + valor
+    static constexpr size_t BYTES_CABECERA_LECTURAS = 1 + 4 + 4; // tipo + canal + k
+    static constexpr size_t LOTES_MAXIMOS = 64;        // lote abierto máximo (en lotes) antes de esperar
+
+    ConfiguracionRegistro config;
+#if defined(_WIN32)
+    HANDLE archivo = INVALID_HANDLE_VALUE;
+#else
+    int archivo = -1;
+#endif
+    std::unordered_map<std::string, uint32_t> canalPorId;
+
+    // Lote abierto: lo llena el hilo que ingesta y lo entrega al llenarse; si la
+    // ingesta se detiene, lo entrega el escritor al vencer el intervalo. Ambos lo
+    // tocan bajo mutexLote (sección corta: sin syscall ni CRC). Sus primeros
+    // BYTES_TRAMA bytes se reservan para la cabecera de la trama.
+    // Orden de bloqueo: mutexLote y luego mutex.
+    std::mutex mutexLote;
+    std::vector<char> activo;
+    size_t entradasActivas = 0;
+
+    // Lote en vuelo: lo escribe el hilo escritor; se intercambia bajo el mutex
+    std::mutex mutex;
+    std::condition_variable hayLote;
+    std::condition_variable loteEscrito;
+    std::vector<char> enVuelo;
+    bool loteAbierto = false;                          // 'activo' tiene entradas (copia bajo mutex)
+    std::chrono::steady_clock::time_point aperturaLote; // cuándo recibió su primera entrada
+    std::atomic<bool> escritorOcupado{false}; // consulta sin bloqueo desde la ingesta
+    bool cerrando = false;
+    bool fallo = false;
+    std::thread escritor;
+
+    template <typename T>
+    static void anexar(std::vector<char>& b, const T& valor) {
+        const char* p = reinterpret_cast<const char*>(&valor);
+        b.insert(b.end(), p, p + sizeof(T));
+    }
+    static void anexar(std::vector<char>& b, std::string_view texto) {
+        anexar(b, static_cast<uint32_t>(texto.size()));
+        b.insert(b.end(), texto.begin(), texto.end());
+    }
+
+    // O(k) - Completar longitud y CRC-32C de la trama (lo hace el hilo escritor)
+    static void sellarTrama(std::vector<char>& trama) {
+        uint32_t longitud = static_cast<uint32_t>(trama.size() - BYTES_TRAMA);
+        uint32_t crc = crc32c(trama.data() + BYTES_TRAMA, longitud);
+        std::memcpy(trama.data(), &longitud, 4);
+        std::memcpy(trama.data() + 4, &crc, 4);
+    }
+
+    // O(1) - Espacio para k bytes más en el lote abierto (abre la trama si está
+    // vacío y avisa al escritor, que desde ahora cuenta la edad del lote).
+    // Precondición: mutexLote tomado
+    char* reservarEnLote(size_t k) {
+        if (activo.empty()) {
+            activo.resize(BYTES_TRAMA);
+            {
+                std::lock_guard<std::mutex> bloqueo(mutex);
+                loteAbierto = true;
+                aperturaLote = std::chrono::steady_clock::now();
+            }
+            hayLote.notify_one();
+        }
+        size_t inicio = activo.size();
+        activo.resize(inicio + k);
+        return activo.data() + inicio;
+    }
+
+    // O(k) - Escribir todo el búfer (reintenta escrituras parciales) y sincronizar
+    bool escribirYSincronizar(const std::vector<char>& datos) {
+#if defined(_WIN32)
+        size_t escritos = 0;
+        while (escritos < datos.size()) {
+            DWORD n = 0;
+            DWORD pedido = static_cast<DWORD>(std::min<size_t>(datos.size() - escritos, 1u << 30));
+            if (!WriteFile(archivo, datos.data() + escritos, pedido, &n, nullptr)) return false;
+            escritos += n;
+        }
+        return !config.sincronizar || FlushFileBuffers(archivo);
+#elif defined(__unix__) || defined(__APPLE__)
+        size_t escritos = 0;
+        while (escritos < datos.size()) {
+            ssize_t n = ::write(archivo, datos.data() + escritos, datos.size() - escritos);
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                return false;
+            }
+            escritos += static_cast<size_t>(n);
+        }
+        if (!config.sincronizar) return true;
+    #if defined(__APPLE__)
+        return ::fsync(archivo) == 0;
+    #else
+        return ::fdatasync(archivo) == 0;
+    #endif
+#else
+        (void)datos;
+        return false;
+#endif
+    }
+
+    // O(1) - Pasar el lote abierto a en vuelo. Precondición: mutexLote y mutex
+    // tomados, enVuelo vacío
+    void tomarLote() {
+        std::swap(activo, enVuelo); // 'activo' recupera la capacidad del lote anterior
+        entradasActivas = 0;
+        loteAbierto = false;
+        escritorOcupado.store(true, std::memory_order_relaxed);
+    }
+
+    // Hilo escritor: toma cada lote en vuelo, lo escribe y avisa al terminar. Sin
+    // lote en vuelo espera a que haya uno o a que el lote abierto cumpla el
+    // intervalo; en ese caso lo toma él (así una ingesta que se detiene queda
+    // igual confirmada en disco a lo sumo un intervalo después)
+    void bucleEscritor() {
+        std::unique_lock<std::mutex> bloqueo(mutex);
+        auto listo = [this] { return !enVuelo.empty() || cerrando; };
+        while (true) {
+            if (!loteAbierto) hayLote.wait(bloqueo, [&] { return listo() || loteAbierto; });
+            if (!listo() && loteAbierto) {
+                auto vencimiento = aperturaLote + config.intervalo;
+                if (!hayLote.wait_until(bloqueo, vencimiento, listo)) {
+                    bloqueo.unlock();
+                    std::lock_guard<std::mutex> lote(mutexLote);
+                    bloqueo.lock();
+                    // La ingesta pudo entregarlo (y abrir otro) mientras tanto
+                    if (enVuelo.empty() && loteAbierto &&
+                        std::chrono::steady_clock::now() >= aperturaLote + config.intervalo) {
+                        tomarLote();
+                    }
+                }
+            }
+            if (enVuelo.empty()) {
+                if (cerrando) break; // sin pendientes
+                continue;
+            }
+            bloqueo.unlock();
+            sellarTrama(enVuelo);
+            bool ok = escribirYSincronizar(enVuelo);
+            bloqueo.lock();
+            if (!ok) fallo = true;
+            enVuelo.clear();
+            escritorOcupado.store(false, std::memory_order_release);
+            loteEscrito.notify_all();
+        }
+    }
+
+    // O(1) + espera si el lote anterior aún se está escribiendo (contrapresión)
+    // Precondición: mutexLote tomado
+    void entregar() {
+        if (activo.empty()) return;
+        {
+            std::unique_lock<std::mutex> bloqueo(mutex);
+            loteEscrito.wait(bloqueo, [this] { return enVuelo.empty(); });
+            tomarLote();
+        }
+        hayLote.notify_one();
+    }
+
+    // O(1) amortizado - Contar k lecturas anotadas y entregar el lote si llegó al
+    // tamaño configurado (la edad la vigila el escritor). Si el escritor aún
+    // sincroniza el lote anterior, la ingesta no espera: el lote abierto sigue
+    // creciendo y el siguiente fsync cubre todo lo acumulado. Solo se espera si
+    // el lote abierto llega a LOTES_MAXIMOS veces el tamaño configurado.
+    // Precondición: mutexLote tomado
+    void quizasEntregar(size_t k) {
+        entradasActivas += k;
+        if (entradasActivas < config.lecturasPorLote) return;
+        if (!escritorOcupado.load(std::memory_order_acquire) ||
+            entradasActivas >= config.lecturasPorLote * LOTES_MAXIMOS) {
+            entregar();
+        }
+    }
+
+    void cerrarArchivo() {
+#if defined(_WIN32)
+        if (archivo != INVALID_HANDLE_VALUE) CloseHandle(archivo);
+        archivo = INVALID_HANDLE_VALUE;
+#elif defined(__unix__) || defined(__APPLE__)
+        if (archivo >= 0) ::close(archivo);
+        archivo = -1;
+#endif
+    }
+
+public:
+    explicit RegistroEscrituraAnticipada(ConfiguracionRegistro config = ConfiguracionRegistro())
+        : config(config) {
+        if (this->config.lecturasPorLote == 0) this->config.lecturasPorLote = 1;
+        activo.reserve(BYTES_TRAMA + this->config.lecturasPorLote * BYTES_LECTURA);
+    }
+
+    // Confirma lo pendiente antes de cerrar
+    ~RegistroEscrituraAnticipada() {
+        if (escritor.joinable()) {
+            {
+                std::lock_guard<std::mutex> lote(mutexLote);
+                entregar();
+            }
+            {
+                std::lock_guard<std::mutex> bloqueo(mutex);
+                cerrando = true;
+            }
+            hayLote.notify_one();
+            escritor.join();
+        }
+        cerrarArchivo();
+    }
+
+    RegistroEscrituraAnticipada(const RegistroEscrituraAnticipada&) = delete;
+    RegistroEscrituraAnticipada& operator=(const RegistroEscrituraAnticipada&) = delete;
+
+    // O(r) - Recorrer un registro existente en orden: enDeclaracion(canal, tipo, id, unidad)
+    // y enLectura(canal, tiempo, valor). Se detiene en la primera trama incompleta
+    // o con CRC inválido (escritura cortada por una caída). Retorna los bytes
+    // válidos (0 si el archivo no existe o está vacío, -1 si no es un registro).
+    template <typename FDeclaracion, typename FLectura>
+    static int64_t reproducir(const std::string& nombreArchivo, FDeclaracion enDeclaracion, FLectura enLectura) {
+        ArchivoMapeado mapeo(nombreArchivo);
+        if (!mapeo.valido()) return 0;
+        std::string_view datos = mapeo.contenido();
+        if (datos.size() < 8 || std::memcmp(datos.data(), MAGIA_REGISTRO, 8) != 0) return -1;
+
+        size_t pos = 8;
+        while (datos.size() - pos >= BYTES_TRAMA) {
+            uint32_t longitud, crc;
+            std::memcpy(&longitud, datos.data() + pos, 4);
+            std::memcpy(&crc, datos.data() + pos + 4, 4);
+            if (longitud == 0 || longitud > datos.size() - pos - BYTES_TRAMA) break;
+            const char* trama = datos.data() + pos + BYTES_TRAMA;
+            if (crc32c(trama, longitud) != crc) break;
+            if (!recorrerTrama(trama, longitud, enDeclaracion, enLectura)) break;
+            pos += BYTES_TRAMA + longitud;
+        }
+        return static_cast<int64_t>(pos);
+    }
+
+    // O(k) - Entradas de una trama íntegra, todo o nada: primero se valida la
+    // trama completa y solo si está bien formada se aplican sus entradas.
+    // Retorna false (sin aplicar ninguna) si alguna está mal formada.
+    template <typename FDeclaracion, typename FLectura>
+    static bool recorrerTrama(const char* p, size_t n, FDeclaracion& enDeclaracion, FLectura& enLectura) {
+        auto ignorarDeclaracion = [](uint32_t, uint32_t, std::string_view, std::string_view) {};
+        auto ignorarLectura = [](uint32_t, int64_t, double) {};
+        if (!decodificarTrama(p, n, ignorarDeclaracion, ignorarLectura)) return false;
+        return decodificarTrama(p, n, enDeclaracion, enLectura);
+    }
+
+private:
+    // O(k) - Decodificar las entradas de una trama en orden, aplicándolas a medida
+    // que se leen; false en la primera mal formada
+    template <typename FDeclaracion, typename FLectura>
+    static bool decodificarTrama(const char* p, size_t n, FDeclaracion& enDeclaracion, FLectura& enLectura) {
+        const char* fin = p + n;
+        while (p < fin) {
+            size_t resto = static_cast<size_t>(fin - p);
+            uint8_t tipo = static_cast<uint8_t>(p[0]);
+            if (tipo == ENTRADA_LECTURA && resto >= BYTES_LECTURA) {
+                uint32_t canal; int64_t tiempo; double valor;
+                std::memcpy(&canal, p + 1, 4);
+                std::memcpy(&tiempo, p + 5, 8);
+                std::memcpy(&valor, p + 13, 8);
+                enLectura(canal, tiempo, valor);
+                p += BYTES_LECTURA;
+            } else if (tipo == ENTRADA_LECTURAS && resto >= BYTES_CABECERA_LECTURAS) {
+                uint32_t canal, k;
+                std::memcpy(&canal, p + 1, 4);
+                std::memcpy(&k, p + 5, 4);
+                if (k == 0 || k > (resto - BYTES_CABECERA_LECTURAS) / 16) return false;
+                const char* tiempos = p + BYTES_CABECERA_LECTURAS;
+                const char* valores = tiempos + size_t(k) * 8;
+                for (uint32_t i = 0; i < k; i++) {
+                    int64_t tiempo; double valor;
+                    std::memcpy(&tiempo, tiempos + size_t(i) * 8, 8);
+                    std::memcpy(&valor, valores + size_t(i) * 8, 8);
+                    enLectura(canal, tiempo, valor);
+                }
+                p += BYTES_CABECERA_LECTURAS + size_t(k) * 16;
+            } else if (tipo == ENTRADA_DECLARACION && resto >= 17) {
+                uint32_t canal, tipoSensor, longitudId, longitudUnidad;
+                std::memcpy(&canal, p + 1, 4);
+                std::memcpy(&tipoSensor, p + 5, 4);
+                std::memcpy(&longitudId, p + 9, 4);
+                if (longitudId > resto - 17) return false;
+                std::memcpy(&longitudUnidad, p + 13 + longitudId, 4);
+                if (longitudUnidad > resto - 17 - longitudId) return false;
+                enDeclaracion(canal, tipoSensor, std::string_view(p + 13, longitudId),
+                              std::string_view(p + 17 + longitudId, longitudUnidad));
+                p += 17 + longitudId + longitudUnidad;
+            } else {
+                return false;
+            }
+        }
+        return true;
+    }
+
+public:
+    // O(1) - Abrir para anexar, recortando lo que siga a los 'bytesValidos' que
+    // devolvió reproducir (0 = archivo nuevo). Lanza el hilo escritor.
+    bool abrir(const std::string& nombreArchivo, int64_t bytesValidos) {
+        if (escritor.joinable() || bytesValidos < 0) return false;
+#if defined(_WIN32)
+        archivo = CreateFileA(nombreArchivo.c_str(), GENERIC_WRITE, FILE_SHARE_READ,
+                              nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (archivo == INVALID_HANDLE_VALUE) return false;
+        LARGE_INTEGER posicion;
+        posicion.QuadPart = bytesValidos;
+        if (!SetFilePointerEx(archivo, posicion, nullptr, FILE_BEGIN) || !SetEndOfFile(archivo)) {
+            cerrarArchivo();
+            return false;
+        }
+#elif defined(__unix__) || defined(__APPLE__)
+        archivo = ::open(nombreArchivo.c_str(), O_WRONLY | O_CREAT, 0644);
+        if (archivo < 0) return false;
+        if (::ftruncate(archivo, bytesValidos) != 0 || ::lseek(archivo, 0, SEEK_END) < 0) {
+            cerrarArchivo();
+            return false;
+        }
+#else
+        (void)nombreArchivo;
+        return false;
+#endif
+        if (bytesValidos == 0) {
+            std::vector<char> cabecera(MAGIA_REGISTRO, MAGIA_REGISTRO + 8);
+            if (!escribirYSincronizar(cabecera)) { cerrarArchivo(); return false; }
+        }
+        escritor = std::thread(&RegistroEscrituraAnticipada::bucleEscritor, this);
+        return true;
+    }
+
+    bool abierto() const { return escritor.joinable(); } // O(1)
+
+    // O(1) promedio - Canal ya asignado a un id (visto al reproducir o declarado)
+    void recordarCanal(std::string_view id, uint32_t canal) { canalPorId[std::string(id)] = canal; }
+
+    // O(|id|) - Canal del sensor; si es nuevo se anota su declaración y se confirma
+    // de inmediato, así ninguna lectura durable queda sin su sensor
+    uint32_t declararSensor(const std::string& id, uint32_t tipoSensor, std::string_view unidad) {
+        auto existente = canalPorId.find(id);
+        if (existente != canalPorId.end()) return existente->second;
+        uint32_t canal = static_cast<uint32_t>(canalPorId.size());
+        canalPorId.emplace(id, canal);
+        {
+            std::lock_guard<std::mutex> lote(mutexLote);
+            reservarEnLote(0);
+            activo.push_back(static_cast<char>(ENTRADA_DECLARACION));
+            anexar(activo, canal);
+            anexar(activo, tipoSensor);
+            anexar(activo, std::string_view(id));
+            anexar(activo, unidad);
+        }
+        confirmar();
+        return canal;
+    }
+
+    // O(1) amortizado - Anotar una lectura en el lote abierto (sin syscall ni CRC;
+    // el bloqueo solo compite con el escritor cuando vence el intervalo)
+    void registrarLectura(uint32_t canal, int64_t tiempo, double valor) {
+        std::lock_guard<std::mutex> lote(mutexLote);
+        char* p = reservarEnLote(BYTES_LECTURA);
+        p[0] = static_cast<char>(ENTRADA_LECTURA);
+        std::memcpy(p + 1, &canal, 4);
+        std::memcpy(p + 5, &tiempo, 8);
+        std::memcpy(p + 13, &valor, 8);
+        quizasEntregar(1);
+    }
+
+    // O(k) - Anotar k lecturas de un canal como entradas columnares (tiempos y
+    // valores contiguos, 16 bytes por lectura), de a lo sumo un lote por entrada
+    void registrarLecturas(uint32_t canal, const int64_t* tiempos, const double* valores, size_t k) {
+        std::lock_guard<std::mutex> lote(mutexLote);
+        while (k > 0) {
+            uint32_t m = static_cast<uint32_t>(std::min(k, config.lecturasPorLote));
+            char* p = reservarEnLote(BYTES_CABECERA_LECTURAS + size_t(m) * 16);
+            p[0] = static_cast<char>(ENTRADA_LECTURAS);
+            std::memcpy(p + 1, &canal, 4);
+            std::memcpy(p + 5, &m, 4);
+            std::memcpy(p + BYTES_CABECERA_LECTURAS, tiempos, size_t(m) * 8);
+            std::memcpy(p + BYTES_CABECERA_LECTURAS + size_t(m) * 8, valores, size_t(m) * 8);
+            tiempos += m;
+            valores += m;
+            k -= m;
+            quizasEntregar(m);
+        }
+    }
+
+    // O(lote) - Entregar el lote abierto y esperar a que todo lo anotado sea durable
+    // Retorna false si alguna escritura o sincronización falló.
+    bool confirmar() {
+        if (!escritor.joinable()) return false;
+        {
+            std::lock_guard<std::mutex> lote(mutexLote);
+            entregar();
+        }
+        std::unique_lock<std::mutex> bloqueo(mutex);
+        loteEscrito.wait(bloqueo, [this] { return enVuelo.empty(); });
+        return !fallo;
+    }
+
+    // O(1) - Recortar el registro tras un punto de control (p. ej. una instantánea
+    // que ya incluye todo lo anotado). Las declaraciones se vuelven a escribir.
+    template <typename FDeclaraciones>
+    bool reiniciar(FDeclaraciones redeclarar) {
+        if (!confirmar()) return false;
+#if defined(_WIN32)
+        LARGE_INTEGER posicion;
+        posicion.QuadPart = 8;
+        if (!SetFilePointerEx(archivo, posicion, nullptr, FILE_BEGIN) || !SetEndOfFile(archivo)) return false;
+#elif defined(__unix__) || defined(__APPLE__)
+        if (::ftruncate(archivo, 8) != 0 || ::lseek(archivo, 0, SEEK_END) < 0) return false;
+#endif
+        canalPorId.clear();
+        redeclarar();
+        return confirmar();
+    }
+
+    bool tieneError() { std::lock_guard<std::mutex> bloqueo(mutex); return fallo; } // O(1)
+};
+
+#endif
@@ -0,0 +1,147 @@
+#ifndef RESUMENBLOQUES_H
+#define RESUMENBLOQUES_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+#include "ColumnaSegmentada.h"
+#include "Estadisticas.h"
+#include "KernelEstadisticas.h"
+
+// Lecturas por bloque de resumen (divide al tamaño de segmento: un bloque nunca
+// cruza segmentos, así sus valores y tiempos son contiguos en memoria)
+constexpr size_t PUNTOS_POR_RESUMEN = 1024;
+static_assert(ColumnaSegmentada<double>::TAM_SEGMENTO % PUNTOS_POR_RESUMEN == 0,
+              "los bloques de resumen deben caber en un segmento");
+
+// ResumenBloques - Agregados precalculados por bloques de posiciones
+// Cada bloque de 1024 lecturas guarda sus agregados (índices absolutos) y su
+// menor y mayor marca de tiempo, mantenidos al agregar. Una consulta por rango
+// de tiempo [t0, t1) combina las cabeceras de los bloques contenidos en el
+// rango y solo recorre los bloques que lo cortan. Si los tiempos llegaron en
+// orden, los bloques del rango se ubican por bisección y solo los dos de los
+// bordes se recorren (también por bisección dentro del bloque). recorrerRango
+// expone ese recorrido para otros resúmenes alineados a los mismos bloques.
+class ResumenBloques {
+private:
+    struct Bloque {
+        Agregados agregados;
+        int64_t tiempoMinimo;
+        int64_t tiempoMaximo;
+    };
+
+    std::vector<Bloque> bloques;
+    size_t n = 0;
+    bool ordenado = true;  // todas las marcas llegaron sin retroceder
+    int64_t ultimoTiempo = 0;
+
+    // O(1) - Bloque abierto (abre uno nuevo cada 1024 lecturas)
+    Bloque& bloqueAbierto(int64_t tiempo) {
+        if (n % PUNTOS_POR_RESUMEN == 0) bloques.push_back({Agregados(), tiempo, tiempo});
+        return bloques.back();
+    }
+
+    // O(1) - Marca de la posición n (la siguiente) y su efecto en el orden
+    void registrarTiempo(Bloque& b, int64_t tiempo) {
+        if (n > 0 && tiempo < ultimoTiempo) ordenado = false;
+        ultimoTiempo = tiempo;
+        b.tiempoMinimo = std::min(b.tiempoMinimo, tiempo);
+        b.tiempoMaximo = std::max(b.tiempoMaximo, tiempo);
+    }
+
+    // O(log B) en orden, O(B) si no - Tramos [i, j) de posiciones contiguas del
+    // bloque b con todos sus tiempos en [t0, t1) (en orden, a lo sumo uno)
+    template <typename FTramo>
+    void recorrerBloque(size_t b, const ColumnaSegmentada<int64_t>& tiempos, int64_t t0, int64_t t1,
+                        FTramo& parcial) const {
+        size_t inicio = b * PUNTOS_POR_RESUMEN;
+        size_t m = std::min(PUNTOS_POR_RESUMEN, n - inicio);
+        const int64_t* t = &tiempos[inicio];
+        if (ordenado) {
+            size_t lo = static_cast<size_t>(std::lower_bound(t, t + m, t0) - t);
+            size_t hi = static_cast<size_t>(std::lower_bound(t + lo, t + m, t1) - t);
+            if (hi > lo) parcial(inicio + lo, inicio + hi);
+            return;
+        }
+        for (size_t i = 0; i < m;) {
+            if (t[i] < t0 || t[i] >= t1) { i++; continue; }
+            size_t j = i + 1;
+            while (j < m && t[j] >= t0 && t[j] < t1) j++;
+            parcial(inicio + i, inicio + j);
+            i = j;
+        }
+    }
+
+public:
+    // O(1) - Incorporar la lectura de la posición siguiente
+    void agregar(double valor, int64_t tiempo) {
+        Bloque& b = bloqueAbierto(tiempo);
+        registrarTiempo(b, tiempo);
+        b.agregados.agregar(valor, n);
+        n++;
+    }
+
+    // O(k) - Incorporar k lecturas contiguas; el kernel resume cada porción de
+    // bloque en una pasada. Retorna los agregados del tramo completo
+    Agregados agregar(const double* valores, const int64_t* tiempos, size_t k) {
+        Agregados tramo;
+        while (k > 0) {
+            Bloque& b = bloqueAbierto(tiempos[0]);
+            size_t cuantos = std::min(k, PUNTOS_POR_RESUMEN - n % PUNTOS_POR_RESUMEN);
+            Agregados porcion = calcularEstadisticas(valores, cuantos).comoAgregados(n);
+            b.agregados.combinar(porcion);
+            tramo.combinar(porcion);
+            for (size_t i = 0; i < cuantos; i++) {
+                registrarTiempo(b, tiempos[i]);
+                n++;
+            }
+            valores += cuantos;
+            tiempos += cuantos;
+            k -= cuantos;
+        }
+        return tramo;
+    }
+
+    // O(log b + bloques del rango) en orden, O(b + B por bloque de borde) si no
+    // Recorrer las lecturas con tiempo en [t0, t1): completo(b) por cada bloque
+    // contenido en el rango y parcial(i, j) por cada tramo de posiciones
+    // contiguas, todas dentro del rango, de los bloques que lo cortan.
+    // 'tiempos' es la columna resumida (puede ser más larga)
+    template <typename FBloque, typename FTramo>
+    void recorrerRango(const ColumnaSegmentada<int64_t>& tiempos, int64_t t0, int64_t t1,
+                       FBloque completo, FTramo parcial) const {
+        if (t0 >= t1) return;
+        auto desde = bloques.begin(), hasta = bloques.end();
+        if (ordenado) {
+            desde = std::partition_point(bloques.begin(), bloques.end(),
+                                         [&](const Bloque& b) { return b.tiempoMaximo < t0; });
+            hasta = std::partition_point(desde, bloques.end(),
+                                         [&](const Bloque& b) { return b.tiempoMinimo < t1; });
+        }
+        for (auto it = desde; it != hasta; ++it) {
+            if (it->tiempoMaximo < t0 || it->tiempoMinimo >= t1) continue;
+            size_t b = static_cast<size_t>(it - bloques.begin());
+            if (it->tiempoMinimo >= t0 && it->tiempoMaximo < t1) completo(b); // solo su cabecera
+            else recorrerBloque(b, tiempos, t0, t1, parcial);
+        }
+    }
+
+    // Igual que recorrerRango - Agregados de las lecturas con tiempo en [t0, t1)
+    // (índices absolutos); los tramos de borde se resumen con el kernel
+    Agregados agregadosEnRango(const ColumnaSegmentada<double>& valores,
+                               const ColumnaSegmentada<int64_t>& tiempos, int64_t t0, int64_t t1) const {
+        Agregados r;
+        recorrerRango(tiempos, t0, t1, [&](size_t b) { r.combinar(bloques[b].agregados); },
+                      [&](size_t i, size_t j) {
+                          r.combinar(calcularEstadisticas(&valores[i], j - i).comoAgregados(i));
+                      });
+        return r;
+    }
+
+    size_t size() const { return n; }                       // O(1)
+    size_t numBloques() const { return bloques.size(); }    // O(1)
+    bool estaOrdenado() const { return ordenado; }          // O(1)
+};
+
+#endif
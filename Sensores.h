@@ -7,77 +7,861 @@
 #include <algorithm>
 #include <memory>
 #include <fstream>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <cstdint>
+#include <functional>
+#include <filesystem>
+#include <limits>
+#include <cmath>
+#include <iterator>
+#include "ArchivoMapeado.h"
+#include "ParseoCSV.h"
+#include "Tiempo.h"
+#include "ColumnaSegmentada.h"
+#include "EjeTiempo.h"
+#include "Estadisticas.h"
+#include "KernelEstadisticas.h"
+#include "ResumenBloques.h"
+#include "IndiceRangos.h"
+#include "IndiceOrden.h"
+#include "BosquejoCuantiles.h"
+#include "Histograma.h"
+#include "SerieComprimida.h"
+#include "VentanaRetencion.h"
+#include "Instantanea.h"
+#include "RegistroEscrituraAnticipada.h"
 
 // Clase base Sensor - Complejidad de métodos en comentarios
 class Sensor {
 protected:
     std::string id;
-    std::vector<double> lecturas;        // O(1) acceso, O(n) búsqueda
-    std::vector<std::string> timestamps; // O(1) acceso, O(n) búsqueda
+    ColumnaSegmentada<double> lecturas;  // O(1) acceso y agregado sin realocar, O(n) búsqueda
+    std::shared_ptr<EjeTiempo> eje;      // Tiempos (propio o compartido) - O(1) acceso, O(n) búsqueda
+    bool ejePropio = true;               // false si el eje lo comparten varios canales
+    Agregados agregados;                 // Mín/máx/suma mantenidos al agregar - O(1) consulta
+    ResumenBloques resumen;              // Agregados por bloques de 1024 - consultas por rango de tiempo
+    BosquejoKLL cuantiles;               // Percentiles aproximados en memoria acotada (todas las lecturas recibidas; se guarda en la instantánea)
+    std::unique_ptr<HistogramaBloques> histograma; // Opcional: conteos por cubetas fijas, total y por bloque
+    std::unique_ptr<TablaDispersa> tablaRangos;  // Opcional: mín/máx por posiciones, O(1), estática
+    std::unique_ptr<ArbolSegmentos> arbolRangos; // Opcional: mín/máx por posiciones, O(log n), al agregar
+    std::unique_ptr<IndiceOrden> indiceOrden;    // Opcional: permutación ordenada, rango/selección O(log n)
+    std::unique_ptr<SerieComprimida> comprimida; // Si existe, reemplaza a lecturas/eje
+    std::unique_ptr<VentanaRetencion> retencion; // Si existe, reemplaza a lecturas/eje
+    RegistroEscrituraAnticipada* registro = nullptr; // WAL donde se anota cada lectura (opcional)
+    uint32_t canalRegistro = 0;
+
+    // O(j - i) crudo o con retención, O(j - i + B) comprimido - Recorrer los puntos
+    // [i, j) por tramos contiguos sin copia persistente: f(tiempos, valores, longitud,
+    // inicio). Comprimido: se decodifica bloque a bloque en un búfer local; con
+    // retención: a lo sumo dos tramos (el buffer circular da la vuelta)
+    template <typename F>
+    void recorrerPuntos(size_t i, size_t j, F f) const {
+        j = std::min(j, getNumLecturas());
+        if (comprimida) { comprimida->recorrerTramos(i, j, f); return; }
+        if (retencion) {
+            const BufferCircular<int64_t>& tiempos = retencion->getTiempos();
+            const BufferCircular<double>& valores = retencion->getValores();
+            // Ambos buffers tienen la misma capacidad e inicio: sus tramos coinciden
+            valores.recorrerTramos(i, j, [&](const double* datos, size_t k, size_t inicio) {
+                f(&tiempos[inicio], datos, k, inicio);
+            });
+            return;
+        }
+        lecturas.recorrerTramos(i, j, [&](const double* datos, size_t k, size_t inicio) {
+            // Los segmentos del eje y de las lecturas tienen el mismo tamaño
+            f(&(*eje).columna()[inicio], datos, k, inicio);
+        });
+    }
+
+    // O(1) - Tiempos en orden no decreciente (solo sin eje: comprimido o con retención)
+    bool tiemposOrdenados() const {
+        return comprimida ? comprimida->estaOrdenada() : retencion->estaOrdenada();
+    }
+
+    // O(log b + B) comprimido, O(log c) con retención - Primera posición con
+    // tiempo >= t (getNumLecturas() si no hay). Precondición: tiemposOrdenados()
+    size_t primeraNoMenor(int64_t t) const {
+        return comprimida ? comprimida->primeraNoMenor(t) : retencion->primeraNoMenor(t);
+    }
+
+    // O(n) - Sin eje y con tiempos sin orden: posición del primer tiempo (en
+    // orden de tiempo, luego de posición) que cumple 'aceptar' y gana según 'mejor'
+    template <typename A, typename M>
+    size_t recorrerBuscando(A aceptar, M mejor) const {
+        size_t elegida = SIN_POSICION;
+        int64_t tiempoElegido = 0;
+        recorrerPuntos(0, getNumLecturas(), [&](const int64_t* tiempos, const double*, size_t k, size_t inicio) {
+            for (size_t q = 0; q < k; q++) {
+                if (aceptar(tiempos[q]) && (elegida == SIN_POSICION || mejor(tiempos[q], tiempoElegido))) {
+                    elegida = inicio + q;
+                    tiempoElegido = tiempos[q];
+                }
+            }
+        });
+        return elegida;
+    }
+
+    // Búsquedas por tiempo en los tres modos (mismo contrato que las de EjeTiempo):
+    // O(log n) crudo (índice del eje); comprimido o con retención, O(log b + B) /
+    // O(log c) con tiempos en orden (bisección sobre las cabeceras de los bloques
+    // o sobre la ventana) y O(n) recorriendo la serie si no.
+
+    // Posición del tiempo más temprano en [t0, t1) (la primera si se repite)
+    size_t primeroEnRango(int64_t t0, int64_t t1) const {
+        if (!comprimida && !retencion) return eje->primeroEnRango(t0, t1, lecturas.size());
+        if (t0 >= t1) return SIN_POSICION;
+        if (!tiemposOrdenados()) {
+            return recorrerBuscando([&](int64_t t) { return t >= t0 && t < t1; },
+                                    [](int64_t t, int64_t elegido) { return t < elegido; });
+        }
+        size_t p = primeraNoMenor(t0);
+        return p < getNumLecturas() && tiempoEn(p) < t1 ? p : SIN_POSICION;
+    }
+
+    // Posición del tiempo más tardío estrictamente anterior a t (la primera si se repite)
+    size_t anteriorA(int64_t t) const {
+        if (!comprimida && !retencion) return eje->anteriorA(t, lecturas.size());
+        if (!tiemposOrdenados()) {
+            return recorrerBuscando([&](int64_t x) { return x < t; },
+                                    [](int64_t x, int64_t elegido) { return x > elegido; });
+        }
+        size_t p = primeraNoMenor(t);
+        return p == 0 ? SIN_POSICION : primeraNoMenor(tiempoEn(p - 1));
+    }
+
+    // Posición del tiempo más temprano >= t (la primera si se repite)
+    size_t siguienteA(int64_t t) const {
+        return primeroEnRango(t, INT64_MAX);
+    }
+
+    // O(n + k) crudo con tiempos en orden - anteriorA y siguienteA de k instantes en
+    // lote; comprimido o con retención, una bisección por consulta con tiempos en
+    // orden o, si no, un eje temporal que se descarta al terminar
+    void vecinosEnLote(const int64_t* consultas, size_t k, size_t* anteriores, size_t* siguientes) const {
+        if (!comprimida && !retencion) {
+            eje->vecinosEnLote(consultas, k, lecturas.size(), anteriores, siguientes);
+        } else if (tiemposOrdenados()) {
+            for (size_t q = 0; q < k; q++) {
+                anteriores[q] = anteriorA(consultas[q]);
+                siguientes[q] = siguienteA(consultas[q]);
+            }
+        } else {
+            EjeTiempo tiempos = ejeTemporal();
+            tiempos.vecinosEnLote(consultas, k, tiempos.size(), anteriores, siguientes);
+        }
+    }
+
+    // O(1) - Elegir entre el vecino anterior y el siguiente de 't' (el más cercano;
+    // ante igual distancia, el anterior). Comprimido: O(B) por vecino
+    size_t masCercano(int64_t t, size_t anterior, size_t siguiente) const {
+        if (anterior == SIN_POSICION) return siguiente;
+        if (siguiente == SIN_POSICION) return anterior;
+        return tiempoEn(siguiente) - t < t - tiempoEn(anterior) ? siguiente : anterior;
+    }
+
+    // O(1) - Valor en 't' a partir de sus vecinos: exacto si hay lectura en 't',
+    // interpolado linealmente entre anterior y siguiente, NaN fuera del rango.
+    // Comprimido: O(B) por vecino
+    double interpolado(int64_t t, size_t anterior, size_t siguiente) const {
+        PuntoSerie s = siguiente != SIN_POSICION ? puntoEn(siguiente) : PuntoSerie{0, 0.0};
+        if (siguiente != SIN_POSICION && s.tiempo == t) return s.valor;
+        if (anterior == SIN_POSICION || siguiente == SIN_POSICION) return std::numeric_limits<double>::quiet_NaN();
+        PuntoSerie a = puntoEn(anterior);
+        double t0 = static_cast<double>(a.tiempo), t1 = static_cast<double>(s.tiempo);
+        return a.valor + (s.valor - a.valor) * ((static_cast<double>(t) - t0) / (t1 - t0));
+    }
+
+    // O(n) - Eje temporal con los tiempos de un sensor comprimido o con retención,
+    // para resolver un lote de consultas cuando los tiempos no están en orden.
+    // Es temporal: se descarta al terminar el lote
+    EjeTiempo ejeTemporal() const {
+        EjeTiempo tiempos;
+        tiempos.reservar(getNumLecturas());
+        recorrerPuntos(0, getNumLecturas(), [&](const int64_t* datos, const double*, size_t k, size_t) {
+            tiempos.agregar(datos, k);
+        });
+        return tiempos;
+    }
+
+    // O(1) - Comparación por (valor, posición), el orden que mantiene IndiceOrden
+    // (almacenamiento crudo)
+    auto comparadorPorValor() const {
+        const ColumnaSegmentada<double>& valores = lecturas;
+        return [&valores](size_t a, size_t b) {
+            return valores[a] < valores[b] || (valores[a] == valores[b] && a < b);
+        };
+    }
+
+    // O(n) - Permutación de posiciones de las lecturas crudas (respaldo sin índice);
+    // con 'ordenar', por (valor, posición) con ordenamiento radix
+    std::vector<size_t> ordenPorValor(bool ordenar) const {
+        std::vector<size_t> orden(lecturas.size());
+        if (ordenar && orden.size() <= UINT32_MAX) {
+            std::vector<ParValorIndice> pares(orden.size());
+            for (size_t i = 0; i < pares.size(); i++) pares[i] = {lecturas[i], static_cast<uint32_t>(i)};
+            ordenarRadixParalelo(pares.data(), pares.size());
+            for (size_t i = 0; i < pares.size(); i++) orden[i] = pares[i].indice;
+            return orden;
+        }
+        for (size_t i = 0; i < orden.size(); i++) orden[i] = i;
+        if (ordenar) std::sort(orden.begin(), orden.end(), comparadorPorValor());
+        return orden;
+    }
+
+    // O(n) - Pares (valor, posición) de un sensor comprimido o con retención,
+    // decodificados en un vector temporal (el orden de std::pair es el de IndiceOrden)
+    std::vector<std::pair<double, size_t>> paresValorPosicion() const {
+        std::vector<std::pair<double, size_t>> pares;
+        pares.reserve(getNumLecturas());
+        recorrerPuntos(0, getNumLecturas(), [&](const int64_t*, const double* valores, size_t k, size_t inicio) {
+            for (size_t q = 0; q < k; q++) pares.emplace_back(valores[q], inicio + q);
+        });
+        return pares;
+    }
+
+    // O(1) crudo o con retención, O(B) comprimido - Punto (tiempo y valor) i
+    PuntoSerie puntoEn(size_t i) const {
+        if (comprimida) return comprimida->punto(i);
+        if (retencion) return PuntoSerie{retencion->tiempo(i), retencion->valor(i)};
+        return PuntoSerie{(*eje)[i], lecturas[i]};
+    }
+
+    // O(1) crudo o con retención, O(B) comprimido - Tiempo de la lectura i
+    int64_t tiempoEn(size_t i) const {
+        if (comprimida) return comprimida->punto(i).tiempo;
+        if (retencion) return retencion->tiempo(i);
+        return (*eje)[i];
+    }
+
+    // O(n) - Copia al escribir: dejar de compartir el eje conservando el prefijo propio
+    void separarEje() {
+        auto propio = std::make_shared<EjeTiempo>();
+        propio->reservar(lecturas.size());
+        for (size_t i = 0; i < lecturas.size(); i++) propio->agregar((*eje)[i]);
+        eje = std::move(propio);
+        ejePropio = true;
+    }
+
+    // O(k log n) - Llevar los índices opcionales hasta las lecturas [desde, n) recién agregadas
+    void indexarNuevas(size_t desde) {
+        if (arbolRangos) arbolRangos->agregar(lecturas, lecturas.size());
+        if (indiceOrden) {
+            for (size_t i = desde; i < lecturas.size(); i++) indiceOrden->agregar(lecturas[i], i);
+        }
+    }
+
+    // O(1) - Los índices opcionales solo existen en almacenamiento crudo
+    void descartarIndices() {
+        tablaRangos.reset();
+        arbolRangos.reset();
+        indiceOrden.reset();
+    }
+
+    // O(1) amortizado sin índices opcionales (ver indexarNuevas) - Punto único
+    // donde entra un valor: actualiza los agregados, el resumen por bloques y
+    // el bosquejo de cuantiles
+    void registrarValor(double valor, int64_t timestamp) {
+        agregados.agregar(valor, lecturas.size());
+        resumen.agregar(valor, timestamp);
+        cuantiles.agregar(valor);
+        if (histograma) histograma->agregar(valor);
+        lecturas.push_back(valor);
+        indexarNuevas(lecturas.size() - 1);
+    }
+
+    // O(k) - Versión masiva de registrarValor: resume el tramo (contiguo en la
+    // entrada) bloque a bloque en una pasada y lo copia por segmentos.
+    // Precondición: sus k tiempos ya están en el eje
+    void registrarValores(const double* valores, size_t k) {
+        size_t base = lecturas.size();
+        eje->columna().recorrerTramos(base, base + k, [&](const int64_t* tiempos, size_t m, size_t inicio) {
+            agregados.combinar(resumen.agregar(valores + (inicio - base), tiempos, m));
+        });
+        cuantiles.agregar(valores, k);
+        if (histograma) histograma->agregar(valores, k);
+        lecturas.agregar(valores, k);
+        indexarNuevas(base);
+    }
 
 public:
     // Constructor: O(1)
-    Sensor(const std::string& id) : id(id) {}
+    Sensor(const std::string& id) : id(id), eje(std::make_shared<EjeTiempo>()) {}
     virtual ~Sensor() = default;
     
-    // O(1) amortizado - push_back en vector
-    virtual void agregarLectura(double valor, const std::string& timestamp) {
-        lecturas.push_back(valor);
-        timestamps.push_back(timestamp);
+    // O(1) - push_back en columna segmentada
+    // Con eje compartido, si la marca ya está en la posición siguiente solo se
+    // agrega el valor; si no coincide, el sensor pasa a tener su propio eje.
+    virtual void agregarLectura(double valor, int64_t timestamp) {
+        if (registro) registro->registrarLectura(canalRegistro, timestamp, valor);
+        aplicarLectura(valor, timestamp);
+    }
+
+    // O(1) - Aplicar una lectura ya anotada en el WAL (o sin WAL)
+    void aplicarLectura(double valor, int64_t timestamp) {
+        if (comprimida) {
+            agregados.agregar(valor, comprimida->size());
+            comprimida->agregar(timestamp, valor);
+            cuantiles.agregar(valor);
+            if (histograma) histograma->agregar(valor);
+            return;
+        }
+        if (retencion) {
+            retencion->agregar(timestamp, valor);
+            cuantiles.agregar(valor);
+            if (histograma) histograma->agregar(valor);
+            return;
+        }
+        if (!ejePropio) {
+            if (eje->size() > lecturas.size() && (*eje)[lecturas.size()] == timestamp) {
+                registrarValor(valor, timestamp);
+                return;
+            }
+            separarEje(); // O(n) - solo la primera vez que el canal se desincroniza
+        }
+        registrarValor(valor, timestamp);
+        eje->agregar(timestamp);
+    }
+    
+    // O(1) - Agregar el valor de la fila que ya está en el eje compartido
+    // Precondición: el eje tiene una marca en la posición lecturas.size()
+    void agregarLecturaEnEje(double valor) {
+        int64_t timestamp = (*eje)[lecturas.size()];
+        if (registro) registro->registrarLectura(canalRegistro, timestamp, valor);
+        registrarValor(valor, timestamp);
+    }
+    
+    // O(k) - Carga masiva: k lecturas con sus tiempos; los agregados del tramo
+    // se calculan con el kernel vectorizado en una sola pasada y se combinan
+    // El tramo se anota en el WAL como una sola entrada columnar.
+    void agregarLecturas(const double* valores, const int64_t* tiempos, size_t k) {
+        if (registro) registro->registrarLecturas(canalRegistro, tiempos, valores, k);
+        if (!ejePropio || comprimida || retencion) {
+            for (size_t i = 0; i < k; i++) aplicarLectura(valores[i], tiempos[i]);
+            return;
+        }
+        eje->reservar(k);
+        eje->agregar(tiempos, k);
+        registrarValores(valores, k);
+    }
+    
+    // O(k) - Carga masiva sobre el eje compartido (los k tiempos ya están en el eje)
+    void agregarLecturasEnEje(const double* valores, size_t k) {
+        if (registro) {
+            eje->columna().recorrerTramos(lecturas.size(), lecturas.size() + k,
+                [&](const int64_t* tiempos, size_t m, size_t inicio) {
+                    registro->registrarLecturas(canalRegistro, tiempos, valores + (inicio - lecturas.size()), m);
+                });
+        }
+        registrarValores(valores, k);
+    }
+    
+    // O(1) - Apuntar a un eje compartido; solo es posible si el sensor aún no
+    // tiene lecturas (así su prefijo coincide siempre con el del eje) y no está
+    // comprimido ni con retención (esos modos guardan sus propios tiempos)
+    bool compartirEje(std::shared_ptr<EjeTiempo> compartido) {
+        if (!lecturas.empty() || comprimida || retencion || !compartido) return false;
+        eje = std::move(compartido);
+        ejePropio = false;
+        return true;
+    }
+    
+    // O(1) - Anotar desde ahora cada lectura en el WAL bajo 'canal' (nullptr desactiva)
+    void enlazarRegistro(RegistroEscrituraAnticipada* wal, uint32_t canal) {
+        registro = wal;
+        canalRegistro = canal;
+    }
+    
+    bool tieneEjeCompartido() const { return !ejePropio; } // O(1)
+    // O(1) - Eje de solo lectura: agregarle marcas desde fuera rompería la invariante
+    // de que cada sensor que lo comparte tiene a lo sumo tantas lecturas como marcas
+    std::shared_ptr<const EjeTiempo> getEje() const { return eje; }
+    
+    // O(1) - Compatibilidad con "AAAA-MM-DD HH:MM:SS"; ignora fechas mal formadas
+    void agregarLectura(double valor, const std::string& timestamp) {
+        int64_t segundos;
+        if (parsearFechaHora(timestamp, segundos)) agregarLectura(valor, segundos);
+    }
+    
+    // O(n) - Pasar al almacenamiento comprimido por bloques (Gorilla)
+    // Las lecturas existentes se recodifican y se libera la memoria cruda.
+    // Retorna false si el sensor ya estaba comprimido.
+    bool activarCompresion(size_t puntosPorBloque = 1024) {
+        if (comprimida || retencion) return false;
+        auto serie = std::make_unique<SerieComprimida>(puntosPorBloque);
+        for (size_t i = 0; i < lecturas.size(); i++) serie->agregar((*eje)[i], lecturas[i]);
+        comprimida = std::move(serie);
+        lecturas.liberar();
+        resumen = ResumenBloques();
+        descartarIndices();
+        if (histograma) histograma->descartarBloques();
+        eje = std::make_shared<EjeTiempo>();
+        ejePropio = true;
+        return true;
+    }
+    
+    // O(c) - Pasar a retención acotada: buffer circular reservado por adelantado
+    // con expulsión O(1). Las lecturas existentes pasan por la política (solo
+    // quedan las más recientes). Mínimo, máximo y promedio pasan a ser los de la
+    // ventana retenida; el bosquejo de cuantiles y el histograma siguen resumiendo
+    // todo lo recibido (y la instantánea los guarda, así sobreviven a un reinicio).
+    // Retorna false si ya hay otro modo o la capacidad es 0.
+    bool activarRetencion(PoliticaRetencion politica) {
+        if (comprimida || retencion || politica.capacidad == 0) return false;
+        auto ventana = std::make_unique<VentanaRetencion>(politica);
+        for (size_t i = 0; i < lecturas.size(); i++) ventana->agregar((*eje)[i], lecturas[i]);
+        retencion = std::move(ventana);
+        lecturas.liberar();
+        resumen = ResumenBloques();
+        descartarIndices();
+        if (histograma) histograma->descartarBloques();
+        eje = std::make_shared<EjeTiempo>();
+        ejePropio = true;
+        agregados = Agregados();
+        return true;
+    }
+    
+    // O(1) - Reponer el bosquejo de cuantiles guardado (instantáneas): con
+    // retención resume también lecturas que la ventana restaurada ya no tiene
+    void restaurarCuantiles(BosquejoKLL bosquejo) { cuantiles = std::move(bosquejo); }
+
+    // O(n + m) - Reponer los conteos totales guardados del histograma con esos
+    // bordes (instantáneas); si el sensor tenía otros bordes se reconfigura primero.
+    // Precondición: 'conteos' tiene bordes.size() + 1 elementos
+    bool restaurarHistograma(std::vector<double> bordes, const uint64_t* conteos) {
+        if (!histograma || histograma->getTotal().getBordes() != bordes) {
+            if (!configurarHistograma(std::move(bordes))) return false;
+        }
+        histograma->restaurarTotal(conteos);
+        return true;
+    }
+
+    bool tieneRetencion() const { return retencion != nullptr; } // O(1)
+    const VentanaRetencion* getRetencion() const { return retencion.get(); } // O(1)
+    
+    // O(k) - Restaurar lecturas crudas con sus agregados ya calculados (instantáneas):
+    // se copian los valores y se reconstruye el resumen por bloques. 'ejeRestaurado' debe
+    // tener al menos k marcas; con 'compartido' se trata como eje de varios canales.
+    // Retorna false si el sensor ya tiene lecturas o usa otro modo.
+    bool restaurarLecturas(std::shared_ptr<EjeTiempo> ejeRestaurado, bool compartido,
+                           const double* valores, size_t k, const Agregados& precalculados) {
+        if (getNumLecturas() > 0 || comprimida || retencion) return false;
+        if (!ejeRestaurado || ejeRestaurado->size() < k || precalculados.n != k) return false;
+        eje = std::move(ejeRestaurado);
+        ejePropio = !compartido;
+        lecturas.reservar(k);
+        eje->columna().recorrerTramos(0, k, [&](const int64_t* tiempos, size_t m, size_t inicio) {
+            resumen.agregar(valores + inicio, tiempos, m);
+        });
+        cuantiles.agregar(valores, k);
+        if (histograma) histograma->agregar(valores, k);
+        lecturas.agregar(valores, k);
+        indexarNuevas(0);
+        agregados = precalculados;
+        return true;
+    }
+    
+    // O(n) - Restaurar una serie comprimida con sus agregados ya calculados (el
+    // bosquejo de cuantiles y el histograma se rehacen decodificando los valores una vez)
+    // Retorna false si el sensor ya tiene lecturas o está en modo retención.
+    bool restaurarComprimida(std::unique_ptr<SerieComprimida> serie, const Agregados& precalculados) {
+        if (getNumLecturas() > 0 || retencion || !serie || serie->size() != precalculados.n) return false;
+        descartarIndices();
+        if (histograma) histograma->descartarBloques();
+        for (const PuntoSerie& p : *serie) {
+            cuantiles.agregar(p.valor);
+            if (histograma) histograma->agregar(p.valor);
+        }
+        comprimida = std::move(serie);
+        lecturas.liberar();
+        eje = std::make_shared<EjeTiempo>();
+        ejePropio = true;
+        agregados = precalculados;
+        return true;
+    }
+    
+    bool estaComprimido() const { return comprimida != nullptr; } // O(1)
+    
+    // O(1) - Serie comprimida para recorrerla con su iterador de decodificación
+    // secuencial sin materializar (nullptr si el sensor no está comprimido)
+    const SerieComprimida* getSerieComprimida() const { return comprimida.get(); }
+    
+    // O(1) - Número de lecturas (retenidas) en cualquier modo de almacenamiento
+    size_t getNumLecturas() const { return retencion ? retencion->size() : agregados.n; }
+    
+    // O(n / 4096) - Reservar de antemano los segmentos para n lecturas adicionales
+    void reservar(size_t n) {
+        if (comprimida || retencion) return; // tienen su propio almacenamiento
+        lecturas.reservar(n);
+        if (ejePropio) eje->reservar(n);
+    }
+    
+    // O(1) - Retornar referencia constante a las columnas (solo almacenamiento crudo)
+    // Un sensor comprimido o con retención no tiene columnas estables que prestar:
+    // devuelve una columna / vista vacía. En cualquier modo, recorrerLecturas /
+    // recorrerTiempos recorren la serie por tramos y getValor / getTiempo dan un punto
+    const ColumnaSegmentada<double>& getLecturas() const {
+        static const ColumnaSegmentada<double> sinColumna;
+        return (comprimida || retencion) ? sinColumna : lecturas;
+    }
+    VistaTiempos getTimestamps() const {
+        if (comprimida || retencion) return VistaTiempos();
+        return VistaTiempos(eje->columna(), lecturas.size());
     }
     
-    // O(1) - Retornar referencia constante
-    const std::vector<double>& getLecturas() const { return lecturas; }
-    const std::vector<std::string>& getTimestamps() const { return timestamps; }
-    std::string getId() const { return id; } // O(1)
+    // Igual que recorrerPuntos - Lecturas [i, j) por tramos: f(datos, longitud, inicio)
+    template <typename F>
+    void recorrerLecturas(size_t i, size_t j, F f) const {
+        recorrerPuntos(i, j, [&](const int64_t*, const double* valores, size_t k, size_t inicio) { f(valores, k, inicio); });
+    }
+    
+    // Igual que recorrerPuntos - Tiempos [i, j) por tramos: f(datos, longitud, inicio)
+    template <typename F>
+    void recorrerTiempos(size_t i, size_t j, F f) const {
+        recorrerPuntos(i, j, [&](const int64_t* tiempos, const double*, size_t k, size_t inicio) { f(tiempos, k, inicio); });
+    }
+    
+    // O(1) crudo o con retención, O(B) comprimido - Valor y tiempo de la lectura i
+    double getValor(size_t i) const { return puntoEn(i).valor; }
+    int64_t getTiempo(size_t i) const { return tiempoEn(i); }
+    const std::string& getId() const { return id; } // O(1) - sin copia
     
     virtual std::string getTipo() const = 0; // O(1) en clases derivadas
     
-    // O(n) - Recorrer todo el vector de lecturas
+    // O(1) - Agregados mantenidos incrementalmente (de la ventana si hay retención)
+    Agregados getAgregados() const { return retencion ? retencion->getAgregados() : agregados; }
+    
+    // O(log n) - Posición de la lectura exactamente en 'timestamp' (la primera si
+    // hay varias); SIN_POSICION si no hay. Sin ordenar ni reservar memoria por consulta
+    size_t buscarPorTiempo(int64_t timestamp) const {
+        return buscarPrimeroEnRango(timestamp, timestamp + 1);
+    }
+    
+    // O(log n) - Posición de la lectura más temprana con tiempo en [t0, t1)
+    // (comprimido: O(log b + B) bisecando las cabeceras de los bloques; con
+    // retención: O(log c); ambos O(n) si los tiempos no llegaron en orden)
+    size_t buscarPrimeroEnRango(int64_t t0, int64_t t1) const {
+        return primeroEnRango(t0, t1);
+    }
+    
+    // O(log n) - Primer y último instante con lecturas (false si no hay lecturas)
+    // (comprimido o con retención: como buscarPrimeroEnRango)
+    bool getRangoTiempos(int64_t& desde, int64_t& hasta) const {
+        if (!comprimida && !retencion) return eje->extremos(lecturas.size(), desde, hasta);
+        size_t n = getNumLecturas();
+        if (n == 0) return false;
+        if (tiemposOrdenados()) {
+            desde = tiempoEn(0);
+            hasta = tiempoEn(n - 1);
+            return true;
+        }
+        desde = INT64_MAX;
+        hasta = INT64_MIN;
+        recorrerPuntos(0, n, [&](const int64_t* tiempos, const double*, size_t k, size_t) {
+            for (size_t q = 0; q < k; q++) {
+                desde = std::min(desde, tiempos[q]);
+                hasta = std::max(hasta, tiempos[q]);
+            }
+        });
+        return true;
+    }
+    
+    // O(log n) - Posición de la lectura más cercana a 'timestamp' (ante igual
+    // distancia, la anterior); SIN_POSICION si el sensor no tiene lecturas
+    // (comprimido o con retención: como buscarPrimeroEnRango)
+    size_t buscarMasCercano(int64_t timestamp) const {
+        return masCercano(timestamp, anteriorA(timestamp), siguienteA(timestamp));
+    }
+    
+    // O(log n) - Valor en 'timestamp': el de la lectura en ese instante o el
+    // interpolado linealmente entre la anterior y la siguiente. Retorna false
+    // fuera del rango de lecturas (no se extrapola)
+    // (comprimido o con retención: como buscarPrimeroEnRango)
+    bool interpolarEn(int64_t timestamp, double& valor) const {
+        valor = interpolado(timestamp, anteriorA(timestamp), siguienteA(timestamp));
+        return !std::isnan(valor);
+    }
+    
+    // O(n + k) mezcla, O(k log(n / k)) galope, O(k log n) con tiempos sin orden -
+    // buscarPorTiempo para k instantes a la vez; 'posiciones' (k elementos, reservado
+    // por quien llama) recibe la posición o SIN_POSICION. Las consultas pueden
+    // venir desordenadas; LOTE_AUTOMATICO galopa si son pocas frente a la serie.
+    // Comprimido o con retención: k búsquedas por bisección con tiempos en orden;
+    // si no, O(n + k log n) sobre un eje temporal que se descarta al terminar
+    void buscarPorTiempos(const int64_t* consultas, size_t k, size_t* posiciones,
+                          EstrategiaLote estrategia = LOTE_AUTOMATICO) const {
+        if (!comprimida && !retencion) {
+            eje->buscarEnLote(consultas, k, lecturas.size(), posiciones, estrategia);
+        } else if (tiemposOrdenados()) {
+            for (size_t q = 0; q < k; q++) posiciones[q] = primeroEnRango(consultas[q], consultas[q] + 1);
+        } else {
+            EjeTiempo tiempos = ejeTemporal();
+            tiempos.buscarEnLote(consultas, k, tiempos.size(), posiciones, estrategia);
+        }
+    }
+    
+    // Igual que buscarPorTiempos - Valores en k instantes exactos; NaN donde no hay lectura
+    void valoresEnTiempos(const int64_t* consultas, size_t k, double* valores,
+                          EstrategiaLote estrategia = LOTE_AUTOMATICO) const {
+        std::vector<size_t> posiciones(k);
+        buscarPorTiempos(consultas, k, posiciones.data(), estrategia);
+        for (size_t q = 0; q < k; q++) {
+            valores[q] = posiciones[q] == SIN_POSICION ? std::numeric_limits<double>::quiet_NaN()
+                                                       : getValor(posiciones[q]);
+        }
+    }
+    
+    // O(n + k) con tiempos en orden, O(k log n) si no - buscarMasCercano para k
+    // instantes en una sola pasada de mezcla; 'posiciones' tiene k elementos
+    // (comprimido o con retención: como buscarPorTiempos)
+    void buscarMasCercanos(const int64_t* consultas, size_t k, size_t* posiciones) const {
+        std::vector<size_t> anteriores(k), siguientes(k);
+        vecinosEnLote(consultas, k, anteriores.data(), siguientes.data());
+        for (size_t q = 0; q < k; q++) posiciones[q] = masCercano(consultas[q], anteriores[q], siguientes[q]);
+    }
+    
+    // O(n + k) con tiempos en orden, O(k log n) si no - interpolarEn para k
+    // instantes en una sola pasada; NaN en los que caen fuera del rango
+    // (comprimido o con retención: como buscarPorTiempos)
+    void interpolarEnLote(const int64_t* consultas, size_t k, double* valores) const {
+        std::vector<size_t> anteriores(k), siguientes(k);
+        vecinosEnLote(consultas, k, anteriores.data(), siguientes.data());
+        for (size_t q = 0; q < k; q++) valores[q] = interpolado(consultas[q], anteriores[q], siguientes[q]);
+    }
+    
+    // O(log b + bloques del rango) - Mínimo/máximo (con su posición), conteo y
+    // promedio de las lecturas con tiempo en [t0, t1). Los bloques de 1024
+    // lecturas contenidos en el rango aportan sus agregados precalculados y solo
+    // se recorren los dos bloques de los bordes (tiempos en orden; si no, cada
+    // bloque que corta el rango). Comprimido: usa las cabeceras de sus bloques.
+    // Con retención: O(c) sobre la ventana, con posiciones relativas a ella
+    Agregados consultarRango(int64_t t0, int64_t t1) const {
+        if (comprimida) return comprimida->agregadosEnRango(t0, t1);
+        if (retencion) return retencion->agregadosEnRango(t0, t1);
+        return resumen.agregadosEnRango(lecturas, eje->columna(), t0, t1);
+    }
+    
+    // O(n) - Contar desde ahora cada lectura en cubetas de bordes fijos (ver
+    // Histograma), total y por bloque de 1024; las lecturas actuales se cuentan al
+    // configurar. Retorna false si los bordes no son finitos y estrictamente crecientes
+    bool configurarHistograma(std::vector<double> bordes) {
+        if (!Histograma::bordesValidos(bordes)) return false;
+        auto nuevo = std::make_unique<HistogramaBloques>(std::move(bordes));
+        if (comprimida || retencion) nuevo->descartarBloques();
+        recorrerLecturas(0, getNumLecturas(), [&](const double* datos, size_t k, size_t) {
+            nuevo->agregar(datos, k);
+        });
+        histograma = std::move(nuevo);
+        return true;
+    }
+    
+    // O(1) - Histograma de todas las lecturas recibidas (nullptr si no se configuró;
+    // con retención incluye las ya expulsadas de la ventana, también tras cargar
+    // una instantánea, que guarda sus conteos totales)
+    const Histograma* getHistograma() const { return histograma ? &histograma->getTotal() : nullptr; }
+    
+    // O(log b + bloques del rango) - Histograma de las lecturas con tiempo en
+    // [t0, t1): los bloques contenidos en el rango suman sus conteos y solo se
+    // recorren las lecturas de los bordes. Comprimido o con retención: se recorren
+    // solo las posiciones del rango si los tiempos están en orden (las encuentra
+    // la bisección), toda la serie si no. Sin histograma configurado, uno vacío
+    // de una sola cubeta
+    Histograma getHistogramaRango(int64_t t0, int64_t t1) const {
+        if (!histograma) return Histograma();
+        Histograma h = histograma->getTotal().vacio();
+        if (histograma->tieneBloques()) {
+            resumen.recorrerRango(eje->columna(), t0, t1, [&](size_t b) { histograma->sumarBloque(b, h); },
+                                  [&](size_t i, size_t j) { for (; i < j; i++) h.agregar(lecturas[i]); });
+            return h;
+        }
+        if (t0 >= t1) return h;
+        if (tiemposOrdenados()) {
+            recorrerLecturas(primeraNoMenor(t0), primeraNoMenor(t1), [&](const double* datos, size_t k, size_t) {
+                for (size_t q = 0; q < k; q++) h.agregar(datos[q]);
+            });
+            return h;
+        }
+        recorrerPuntos(0, getNumLecturas(), [&](const int64_t* tiempos, const double* valores, size_t k, size_t) {
+            for (size_t q = 0; q < k; q++) {
+                if (tiempos[q] >= t0 && tiempos[q] < t1) h.agregar(valores[q]);
+            }
+        });
+        return h;
+    }
+    
+    // O(j - i) - Estadísticas de un tramo arbitrario [i, j) con el kernel vectorizado
+    // aplicado segmento a segmento (comprimido: bloque a bloque, O(j - i + B)).
+    // Los índices del resultado son absolutos
+    ResumenEstadistico getEstadisticasTramo(size_t i, size_t j) const {
+        ResumenEstadistico r;
+        recorrerLecturas(i, j, [&](const double* datos, size_t k, size_t inicio) {
+            r.combinar(calcularEstadisticas(datos, k), inicio);
+        });
+        return r;
+    }
+    
+    // O(n) - Construir la tabla dispersa de mín/máx por posiciones sobre las
+    // lecturas actuales (para datos que ya no cambian: las lecturas que lleguen
+    // después quedan fuera de la tabla). Solo en almacenamiento crudo
+    bool construirTablaDispersa() {
+        if (comprimida || retencion) return false;
+        tablaRangos = std::make_unique<TablaDispersa>(lecturas);
+        return true;
+    }
+    
+    // O(n) - Activar el árbol de segmentos de mín/máx por posiciones; desde ahora
+    // cada lectura lo actualiza en O(log(n/32)) (sube mientras sea un nuevo
+    // extremo: hasta la raíz en una serie con tendencia). Solo en almacenamiento crudo
+    bool activarArbolSegmentos() {
+        if (comprimida || retencion) return false;
+        if (!arbolRangos) {
+            arbolRangos = std::make_unique<ArbolSegmentos>();
+            arbolRangos->agregar(lecturas, lecturas.size());
+        }
+        return true;
+    }
+    
+    // O(1) con tabla dispersa que cubra el tramo, O(log n) con árbol de segmentos,
+    // O(j - i) sin índice - Posiciones del mínimo y del máximo de las lecturas [i, j)
+    ExtremosTramo getExtremosTramo(size_t i, size_t j) const {
+        j = std::min(j, getNumLecturas());
+        if (i >= j) return ExtremosTramo();
+        if (tablaRangos && j <= tablaRangos->size()) return tablaRangos->consultar(lecturas, i, j);
+        if (arbolRangos) return arbolRangos->consultar(lecturas, i, j);
+        ResumenEstadistico r = getEstadisticasTramo(i, j);
+        return ExtremosTramo{r.indiceMinimo, r.indiceMaximo};
+    }
+    
+    // O(n log n) - Construir la permutación ordenada de las lecturas; desde ahora se
+    // mantiene en O(log n + B) por lectura. Solo en almacenamiento crudo
+    bool activarIndiceOrden() {
+        if (comprimida || retencion) return false;
+        if (!indiceOrden) indiceOrden = std::make_unique<IndiceOrden>(lecturas);
+        return true;
+    }
+    
+    bool tieneIndiceOrden() const { return indiceOrden != nullptr; } // O(1)
+    
+    // O(log n) con índice de orden, O(n) sin él - Posición de la lectura con el
+    // k-ésimo menor valor (k desde 0; empates por posición). SIN_POSICION si k >= n
+    size_t getPosicionKesima(size_t k) const {
+        if (k >= getNumLecturas()) return SIN_POSICION;
+        if (indiceOrden) return indiceOrden->seleccionar(k);
+        if (comprimida || retencion) {
+            std::vector<std::pair<double, size_t>> pares = paresValorPosicion();
+            std::nth_element(pares.begin(), pares.begin() + k, pares.end());
+            return pares[k].second;
+        }
+        std::vector<size_t> orden = ordenPorValor(false);
+        std::nth_element(orden.begin(), orden.begin() + k, orden.end(), comparadorPorValor());
+        return orden[k];
+    }
+    
+    // O(log n) con índice de orden, O(n) sin él - Cuántas lecturas valen menos que 'valor'
+    size_t getRango(double valor) const {
+        if (indiceOrden) return indiceOrden->rango(valor);
+        size_t menores = 0;
+        recorrerLecturas(0, getNumLecturas(), [&](const double* datos, size_t k, size_t) {
+            for (size_t i = 0; i < k; i++) menores += datos[i] < valor;
+        });
+        return menores;
+    }
+    
+    // O(1) - Bosquejo KLL de todas las lecturas recibidas (con retención incluye
+    // las ya expulsadas de la ventana, también tras cargar una instantánea, que
+    // guarda el bosquejo); combinable con el de otros sensores
+    const BosquejoKLL& getBosquejoCuantiles() const { return cuantiles; }
+    
+    // O(k log k) - Percentil p (0..100) aproximado con el bosquejo, sin ordenar
+    // la serie ni construir índices (error de rango ~1 %, ver BosquejoKLL)
+    double getPercentilAproximado(double p) const {
+        return cuantiles.cuantil(std::min(100.0, std::max(0.0, p)) / 100.0);
+    }
+    
+    // Igual que getPosicionKesima - Percentil p (0..100) por rango más cercano
+    double getPercentil(double p) const {
+        size_t n = getNumLecturas();
+        if (n == 0) return 0.0;
+        p = std::min(100.0, std::max(0.0, p));
+        size_t k = static_cast<size_t>(std::ceil(p / 100.0 * static_cast<double>(n)));
+        return getValor(getPosicionKesima(k == 0 ? 0 : k - 1));
+    }
+    
+    // O(n) con índice de orden, O(n log n) sin él - Llamar f(valor, posición) en
+    // orden ascendente de valor (empates por posición)
+    template <typename F>
+    void recorrerEnOrden(F f) const {
+        if (indiceOrden) { indiceOrden->recorrer(f); return; }
+        if (comprimida || retencion) {
+            std::vector<std::pair<double, size_t>> pares = paresValorPosicion();
+            std::sort(pares.begin(), pares.end());
+            for (const auto& par : pares) f(par.first, par.second);
+            return;
+        }
+        for (size_t i : ordenPorValor(true)) f(lecturas[i], i);
+    }
+    
+    // Igual que getExtremosTramo - Hora del máximo / mínimo de las lecturas [i, j)
+    std::string getTimestampMaximoTramo(size_t i, size_t j) const {
+        ExtremosTramo e = getExtremosTramo(i, j);
+        return e.vacio() ? "" : formatearHora(tiempoEn(e.indiceMaximo));
+    }
+    std::string getTimestampMinimoTramo(size_t i, size_t j) const {
+        ExtremosTramo e = getExtremosTramo(i, j);
+        return e.vacio() ? "" : formatearHora(tiempoEn(e.indiceMinimo));
+    }
+    
+    // O(1) - Valor cacheado
     double getMaximo() const {
-        if (lecturas.empty()) return 0.0;
-        return *std::max_element(lecturas.begin(), lecturas.end());
+        Agregados a = getAgregados();
+        return a.n == 0 ? 0.0 : a.maximo;
     }
     
-    // O(n) - Recorrer todo el vector de lecturas
+    // O(1) - Valor cacheado
     double getMinimo() const {
-        if (lecturas.empty()) return 0.0;
-        return *std::min_element(lecturas.begin(), lecturas.end());
+        Agregados a = getAgregados();
+        return a.n == 0 ? 0.0 : a.minimo;
     }
     
-    // O(n) - Sumar todos los elementos
+    // O(1) - Suma compensada / conteo
     double getPromedio() const {
-        if (lecturas.empty()) return 0.0;
-        double suma = 0.0;
-        for (double lectura : lecturas) { // O(n)
-            suma += lectura;
-        }
-        return suma / lecturas.size();
+        return getAgregados().promedio();
+    }
+    
+    // O(1) - Varianza muestral (n - 1) con los momentos de Welford mantenidos al
+    // agregar (de la ventana si hay retención); 0 con menos de dos lecturas
+    double getVarianza() const {
+        return getAgregados().varianza();
+    }
+    
+    // O(1) - Raíz de getVarianza
+    double getDesviacionEstandar() const {
+        return getAgregados().desviacionEstandar();
     }
     
-    // O(n) - Encontrar máximo + acceso por índice
+    // O(1) - Índice del máximo cacheado + acceso por índice
     std::string getTimestampMaximo() const {
-        if (lecturas.empty()) return "";
-        auto it = std::max_element(lecturas.begin(), lecturas.end()); // O(n)
-        size_t index = std::distance(lecturas.begin(), it); // O(1)
-        return timestamps[index].substr(11, 5); // O(1)
+        Agregados a = getAgregados();
+        if (a.n == 0) return "";
+        return formatearHora(tiempoEn(a.indiceMaximo)); // O(1)
     }
     
-    // O(n) - Encontrar mínimo + acceso por índice
+    // O(1) - Índice del mínimo cacheado + acceso por índice
     std::string getTimestampMinimo() const {
-        if (lecturas.empty()) return "";
-        auto it = std::min_element(lecturas.begin(), lecturas.end()); // O(n)
-        size_t index = std::distance(lecturas.begin(), it); // O(1)
-        return timestamps[index].substr(11, 5); // O(1)
+        Agregados a = getAgregados();
+        if (a.n == 0) return "";
+        return formatearHora(tiempoEn(a.indiceMinimo)); // O(1)
     }
     
-    // O(n) - Por llamar a getMinimo, getMaximo, getPromedio
+    // O(1) - Todos los valores están cacheados
     void mostrarResumen() const {
         std::cout << "=== " << getTipo() << " - " << id << " ===" << std::endl;
-        std::cout << "Lecturas: " << lecturas.size() << std::endl; // O(1)
-        std::cout << "Mínimo: " << getMinimo() << " (" << getTimestampMinimo() << ")" << std::endl; // O(n)
-        std::cout << "Máximo: " << getMaximo() << " (" << getTimestampMaximo() << ")" << std::endl; // O(n)
-        std::cout << "Promedio: " << getPromedio() << std::endl; // O(n)
+        std::cout << "Lecturas: " << getNumLecturas() << std::endl; // O(1)
+        std::cout << "Mínimo: " << getMinimo() << " (" << getTimestampMinimo() << ")" << std::endl; // O(1)
+        std::cout << "Máximo: " << getMaximo() << " (" << getTimestampMaximo() << ")" << std::endl; // O(1)
+        std::cout << "Promedio: " << getPromedio() << std::endl; // O(1)
     }
 };
 
@@ -101,7 +885,7 @@ public:
         return unidad;
     }
     
-    // O(n) - Por llamar a getMaximo que es O(n)
+    // O(1) - getMaximo está cacheado
     bool tieneFiebre() const {
         return getMaximo() > 38.0;
     }
@@ -109,94 +893,702 @@ public:
 
 // SensorHumedad - Complejidad similar
 class SensorHumedad : public Sensor {
+private:
+    // O(1) - Fracción de cada banda de confort en 'h' (vacío si tiene otros bordes)
+    static std::vector<std::pair<std::string, double>> distribucionConfort(const Histograma& h) {
+        std::vector<std::pair<std::string, double>> bandas;
+        if (!std::equal(h.getBordes().begin(), h.getBordes().end(), std::begin(BORDES_CONFORT), std::end(BORDES_CONFORT))) {
+            return bandas;
+        }
+        for (size_t c = 0; c < h.numCubetas(); c++) bandas.emplace_back(NIVELES_CONFORT[c], h.fraccion(c));
+        return bandas;
+    }
+
 public:
-    // O(1) - Constructor
+    // Bandas de confort: NIVELES_CONFORT[i] va de BORDES_CONFORT[i - 1] a BORDES_CONFORT[i]
+    static constexpr double BORDES_CONFORT[] = {30, 40, 60, 70};
+    static constexpr const char* NIVELES_CONFORT[] = {"Muy seco", "Seco", "Confortable", "Húmedo", "Muy húmedo"};
+    
+    // O(1) - Constructor (sin histograma: ver activarDistribucionConfort)
     SensorHumedad(const std::string& id) : Sensor(id) {}
     
+    // O(n) - Configurar el histograma con las bandas de confort, necesario para
+    // getDistribucionConfort; desde ahora cada lectura paga O(log 5) y cada bloque
+    // de 1024 lecturas sus conteos (ver configurarHistograma)
+    bool activarDistribucionConfort() {
+        return configurarHistograma(std::vector<double>(std::begin(BORDES_CONFORT), std::end(BORDES_CONFORT)));
+    }
+    
     // O(1) - Retorno constante
     std::string getTipo() const override {
         return "Sensor de Humedad";
     }
     
-    // O(n) - Por llamar a getPromedio que es O(n)
+    // O(1) - getPromedio está cacheado
     std::string getNivelConfort() const {
-        double promedio = getPromedio(); // O(n)
-        if (promedio < 30) return "Muy seco";
-        if (promedio < 40) return "Seco";
-        if (promedio < 60) return "Confortable";
-        if (promedio < 70) return "Húmedo";
-        return "Muy húmedo";
+        double promedio = getPromedio(); // O(1)
+        size_t banda = 0;
+        while (banda < std::size(BORDES_CONFORT) && !(promedio < BORDES_CONFORT[banda])) banda++;
+        return NIVELES_CONFORT[banda];
+    }
+    
+    // O(1) - Fracción de las lecturas en cada banda de confort, de "Muy seco" a
+    // "Muy húmedo" (con muestreo regular, la fracción del tiempo). Vacío si no se
+    // activó la distribución o el histograma se reconfiguró con otros bordes
+    std::vector<std::pair<std::string, double>> getDistribucionConfort() const {
+        return getHistograma() ? distribucionConfort(*getHistograma()) : std::vector<std::pair<std::string, double>>();
+    }
+    
+    // Igual que getHistogramaRango - Distribución de confort de las lecturas con tiempo en [t0, t1)
+    std::vector<std::pair<std::string, double>> getDistribucionConfort(int64_t t0, int64_t t1) const {
+        return distribucionConfort(getHistogramaRango(t0, t1));
+    }
+};
+
+// EnlaceColumna - Asocia una columna del encabezado del CSV con un sensor
+// Si el sensor no está registrado se crea con 'crear' (si se configuró).
+struct EnlaceColumna {
+    std::string columna;
+    std::string idSensor;
+    std::function<std::unique_ptr<Sensor>(const std::string&)> crear;
+};
+
+// ConfiguracionCSV - Columna de fecha y enlaces columna -> sensor
+struct ConfiguracionCSV {
+    std::string columnaFecha = "Fecha";
+    std::vector<EnlaceColumna> enlaces;
+
+    // O(e) - Ningún id de sensor enlazado a dos columnas
+    static bool sensoresUnicos(const std::vector<EnlaceColumna>& enlaces) {
+        std::unordered_set<std::string_view> ids;
+        for (const auto& enlace : enlaces) {
+            if (!ids.insert(enlace.idSensor).second) return false;
+        }
+        return true;
+    }
+
+    // O(1) - Formato de datos.csv: Temperatura -> TEMP_001, Humedad -> HUM_001
+    static ConfiguracionCSV porDefecto() {
+        ConfiguracionCSV config;
+        config.enlaces.push_back({"Temperatura", "TEMP_001", [](const std::string& id) {
+            return std::unique_ptr<Sensor>(std::make_unique<SensorTemperatura>(id));
+        }});
+        config.enlaces.push_back({"Humedad", "HUM_001", [](const std::string& id) {
+            return std::unique_ptr<Sensor>(std::make_unique<SensorHumedad>(id));
+        }});
+        return config;
     }
 };
 
+// Manejador estable de un sensor dentro de SistemaSensores (su posición de registro)
+// Se resuelve una vez por id y luego se usa en ciclos sin volver a buscar.
+using ManejadorSensor = uint32_t;
+constexpr ManejadorSensor SIN_SENSOR = UINT32_MAX;
+
 // SistemaSensores - Gestión de múltiples sensores
 class SistemaSensores {
 private:
     std::vector<std::unique_ptr<Sensor>> sensores; // O(m) donde m = número de sensores
+    // Índice id -> manejador. Las claves son vistas sobre el id de cada sensor,
+    // que vive en el heap y no cambia: búsqueda con string_view sin construir std::string.
+    std::unordered_map<std::string_view, ManejadorSensor> indicePorId;
+    ConfiguracionCSV configuracionCSV = ConfiguracionCSV::porDefecto();
+    std::unique_ptr<RegistroEscrituraAnticipada> registro; // WAL activo (opcional)
 
 public:
-    // O(1) amortizado - push_back en vector
-    void agregarSensor(std::unique_ptr<Sensor> sensor) {
+    // O(1) amortizado - push_back en vector + inserción en el índice
+    // Si el id ya existe, el índice conserva el primer sensor registrado
+    ManejadorSensor agregarSensor(std::unique_ptr<Sensor> sensor) {
+        ManejadorSensor manejador = static_cast<ManejadorSensor>(sensores.size());
+        std::string_view clave = sensor->getId();
         sensores.push_back(std::move(sensor));
+        indicePorId.emplace(clave, manejador);
+        if (registro) enlazarConRegistro(*sensores.back());
+        return manejador;
     }
     
-    // O(m) - Búsqueda lineal en vector de sensores
-    Sensor* buscarSensor(const std::string& id) {
-        for (auto& sensor : sensores) { // O(m)
-            if (sensor->getId() == id) {
-                return sensor.get();
-            }
+    // O(1) promedio - Resolver un id a su manejador (SIN_SENSOR si no existe)
+    ManejadorSensor resolverSensor(std::string_view id) const {
+        auto it = indicePorId.find(id);
+        return it == indicePorId.end() ? SIN_SENSOR : it->second;
+    }
+    
+    // O(1) - Acceso directo por manejador, sin hash ni comparación de cadenas
+    // (solo lectura desde un sistema constante)
+    Sensor* sensorPorManejador(ManejadorSensor manejador) {
+        return manejador < sensores.size() ? sensores[manejador].get() : nullptr;
+    }
+    const Sensor* sensorPorManejador(ManejadorSensor manejador) const {
+        return manejador < sensores.size() ? sensores[manejador].get() : nullptr;
+    }
+    
+    // O(1) promedio - Búsqueda en el índice hash
+    Sensor* buscarSensor(std::string_view id) {
+        return sensorPorManejador(resolverSensor(id));
+    }
+    const Sensor* buscarSensor(std::string_view id) const {
+        return sensorPorManejador(resolverSensor(id));
+    }
+    
+    size_t numSensores() const { return sensores.size(); } // O(1)
+    
+    // O(m k) - Bosquejo combinado de los sensores de un tipo (de todos si 'tipo'
+    // está vacío) para percentiles de la flota, p. ej. combinarCuantiles("Sensor de Temperatura")
+    BosquejoKLL combinarCuantiles(const std::string& tipo = "") const {
+        BosquejoKLL flota;
+        for (const auto& sensor : sensores) {
+            if (tipo.empty() || sensor->getTipo() == tipo) flota.combinar(sensor->getBosquejoCuantiles());
         }
-        return nullptr;
+        return flota;
+    }
+    
+    // O(e) - Cambiar los enlaces columna -> sensor usados por los cargadores
+    // Retorna false (sin cambiar nada) si dos enlaces apuntan al mismo sensor:
+    // cada sensor recibe a lo sumo una columna por fila
+    bool configurarCSV(ConfiguracionCSV config) {
+        if (!ConfiguracionCSV::sensoresUnicos(config.enlaces)) return false;
+        configuracionCSV = std::move(config);
+        return true;
     }
     
-    // O(m * n) - Donde m = sensores, n = lecturas por sensor
+    // O(m) - Donde m = sensores (los resúmenes son O(1))
     void mostrarTodosLosSensores() const {
         std::cout << "\n=== SISTEMA DE SENSORES ===" << std::endl;
         std::cout << "Total de sensores: " << sensores.size() << std::endl;
         
         for (const auto& sensor : sensores) { // O(m)
-            sensor->mostrarResumen(); // O(n) por sensor
+            sensor->mostrarResumen(); // O(1) por sensor
             std::cout << std::endl;
         }
     }
     
     // O(l) - Donde l = líneas en el archivo CSV
+    // Los sensores se enlazan una vez a partir del encabezado; cada fila después
+    // solo parsea sus campos y los entrega a los canales ya resueltos. El archivo
+    // se lee por bloques y sus filas se cortan con el mismo escáner estructural
+    // que usa cargarDesdeCSVMapeado (recorrerFilas).
     bool cargarDesdeCSV(const std::string& nombreArchivo) {
-        std::ifstream file(nombreArchivo);
+        std::ifstream file(nombreArchivo, std::ios::binary);
         if (!file.is_open()) return false;
 
         std::string line;
-        std::getline(file, line); // O(1) - encabezado
+        std::getline(file, line); // O(c) - encabezado, c = columnas
+
+        // O(c) - Enlazar columnas con sensores (creándolos si hace falta)
+        auto eje = std::make_shared<EjeTiempo>();
+        PlanColumnas plan;
+        std::vector<CanalCarga> canales;
+        if (!enlazarColumnas(line, eje, plan, canales)) return false;
+
+        // O(l) - Bloques de 1 MiB: se recorren sus filas completas y la fila
+        // cortada al final pasa al comienzo del bloque siguiente
+        constexpr size_t BLOQUE_LECTURA = size_t(1) << 20;
+        std::vector<double> fila(canales.size());
+        auto porFila = [&](const std::vector<std::string_view>& campos) {
+            procesarFila(campos, plan, *eje, canales, fila);
+        };
+        std::string buffer;
+        size_t pendiente = 0;
+        while (true) {
+            buffer.resize(pendiente + BLOQUE_LECTURA);
+            file.read(&buffer[pendiente], BLOQUE_LECTURA);
+            size_t llenos = pendiente + static_cast<size_t>(file.gcount());
+            std::string_view leido(buffer.data(), llenos);
+            if (!file) { // Fin del archivo: la última fila puede no tener '\n'
+                recorrerFilas(leido, porFila);
+                break;
+            }
+            size_t finLinea = leido.rfind('\n');
+            size_t completas = finLinea == std::string_view::npos ? 0 : finLinea + 1;
+            recorrerFilas(leido.substr(0, completas), porFila);
+            buffer.erase(0, completas);
+            pendiente = llenos - completas;
+        }
+        return true;
+    }
+
+    // O(l) - Carga sobre el archivo mapeado en memoria, sin copias por fila
+    // Las líneas y campos son std::string_view sobre la región mapeada;
+    // si el mapeo no está disponible se usa cargarDesdeCSV como respaldo.
+    bool cargarDesdeCSVMapeado(const std::string& nombreArchivo) {
+        ArchivoMapeado archivo(nombreArchivo);
+        if (!archivo.valido()) return cargarDesdeCSV(nombreArchivo);
+
+        std::string_view datos = archivo.contenido();
+        size_t inicioDatos = saltarEncabezado(datos);
+
+        // O(c) - Resolver los sensores una sola vez por archivo
+        auto eje = std::make_shared<EjeTiempo>();
+        PlanColumnas plan;
+        std::vector<CanalCarga> canales;
+        if (!enlazarColumnas(datos.substr(0, inicioDatos), eje, plan, canales)) return false;
+
+        // O(l) - Recorrer las líneas directamente sobre el mapeo
+        std::vector<double> fila(canales.size());
+        recorrerFilas(datos.substr(inicioDatos), [&](const std::vector<std::string_view>& campos) {
+            procesarFila(campos, plan, *eje, canales, fila);
+        });
+        return true;
+    }
+
+    // O(l / h + l) - Carga paralela: h hilos parsean bloques contiguos del archivo
+    // mapeado en búferes de columnas propios, y luego se fusionan en orden original.
+    // El resultado es idéntico bit a bit al de cargarDesdeCSVMapeado (lo comprueba
+    // benchmarks/bench_carga.cpp). hilos = 0 usa todos los núcleos.
+    bool cargarDesdeCSVParalelo(const std::string& nombreArchivo, unsigned hilos = 0) {
+        ArchivoMapeado archivo(nombreArchivo);
+        if (!archivo.valido()) return cargarDesdeCSV(nombreArchivo);
+
+        if (hilos == 0) hilos = std::max(1u, std::thread::hardware_concurrency());
+        std::string_view datos = archivo.contenido();
+        size_t inicioDatos = saltarEncabezado(datos);
 
-        // O(1) - Crear sensores si no existen
-        if (sensores.empty()) {
-            sensores.push_back(std::make_unique<SensorTemperatura>("TEMP_001"));
-            sensores.push_back(std::make_unique<SensorHumedad>("HUM_001"));
+        // O(c) - Enlazar columnas antes de lanzar los hilos (el plan es de solo lectura)
+        auto eje = std::make_shared<EjeTiempo>();
+        PlanColumnas plan;
+        std::vector<CanalCarga> canales;
+        if (!enlazarColumnas(datos.substr(0, inicioDatos), eje, plan, canales)) return false;
+        datos.remove_prefix(inicioDatos);
+
+        // O(h) - Cortar en límites de línea: cada corte avanza hasta después de un '\n'
+        std::vector<size_t> cortes{0};
+        for (unsigned h = 1; h < hilos; h++) {
+            size_t corte = std::max(cortes.back(), datos.size() * h / hilos);
+            size_t fin = datos.find('\n', corte);
+            corte = (fin == std::string_view::npos) ? datos.size() : fin + 1;
+            if (corte > cortes.back() && corte < datos.size()) cortes.push_back(corte);
+        }
+        cortes.push_back(datos.size());
+
+        // O(l / h) - Parsear cada bloque en su propio hilo
+        size_t numBloques = cortes.size() - 1;
+        std::vector<ColumnasCSV> columnas(numBloques);
+        std::vector<std::thread> trabajadores;
+        for (size_t b = 1; b < numBloques; b++) {
+            trabajadores.emplace_back([&, b] {
+                parsearBloque(datos.substr(cortes[b], cortes[b+1] - cortes[b]), plan, columnas[b]);
+            });
+        }
+        parsearBloque(datos.substr(cortes[0], cortes[1] - cortes[0]), plan, columnas[0]);
+        for (auto& t : trabajadores) t.join();
+
+        // O(l) - Fusionar en el orden original del archivo
+        size_t total = 0;
+        for (const auto& c : columnas) total += c.fechas.size();
+        eje->reservar(total);
+        for (auto& canal : canales) canal.sensor->reservar(total);
+
+        // Fila por fila, igual que procesarFila: los agregados masivos (kernel por
+        // tramo y combinación) dependerían de dónde cayeron los cortes
+        for (const auto& c : columnas) {
+            for (size_t i = 0; i < c.fechas.size(); i++) {
+                eje->agregar(c.fechas[i]);
+                for (size_t k = 0; k < canales.size(); k++) canales[k].agregar(c.valores[k][i], c.fechas[i]);
+            }
+        }
+        return true;
+    }
+
+    // O(n) - Guardar todos los sensores en una instantánea binaria columnar (formato
+    // en Instantanea.h). Se escribe a un temporal que, ya sincronizado, reemplaza
+    // al archivo; luego se sincroniza el directorio. Así ni una escritura
+    // interrumpida ni un corte de energía dejan una instantánea a medias.
+    bool guardarInstantanea(const std::string& nombreArchivo) const {
+        // O(m) - Tabla de sensores y de ejes (los compartidos se guardan una vez)
+        std::vector<SensorInstantanea> tabla(sensores.size());
+        std::vector<std::string> unidades(sensores.size());
+        std::vector<VistaTiempos> ejes;
+        std::vector<const Sensor*> ejeRetenido; // por eje: el sensor con retención cuya ventana se guarda (o nullptr)
+        std::unordered_map<const EjeTiempo*, uint64_t> ejePorPuntero;
+        for (size_t i = 0; i < sensores.size(); i++) {
+            const Sensor& sensor = *sensores[i];
+            SensorInstantanea& si = tabla[i];
+            si = SensorInstantanea{};
+            si.eje = SIN_EJE;
+            si.tipo = tipoDeSensor(sensor, unidades[i]);
+            si.numLecturas = sensor.getNumLecturas();
+            si.agregados = AgregadosInstantanea::desde(sensor.getAgregados());
+
+            if (const SerieComprimida* serie = sensor.getSerieComprimida()) {
+                si.modo = MODO_COMPRIMIDO;
+                si.puntosPorBloque = serie->getPuntosPorBloque();
+                si.numBloques = serie->getBloques().size();
+            } else if (const VentanaRetencion* ventana = sensor.getRetencion()) {
+                si.modo = MODO_RETENCION;
+                si.capacidadRetencion = ventana->getPolitica().capacidad;
+                si.ventanaSegundos = ventana->getPolitica().ventanaSegundos;
+                si.eje = ejes.size();
+                ejes.emplace_back();
+                ejeRetenido.push_back(&sensor);
+            } else {
+                si.modo = MODO_CRUDO;
+                const EjeTiempo* eje = sensor.getEje().get();
+                auto insertado = ejePorPuntero.emplace(eje, ejes.size());
+                if (insertado.second) {
+                    ejes.push_back(VistaTiempos(eje->columna(), eje->size()));
+                    ejeRetenido.push_back(nullptr);
+                }
+                si.eje = insertado.first->second;
+            }
+        }
+
+        // O(m + e + b) - Asignar desplazamientos en el mismo orden en que se escribe
+        uint64_t pos = sizeof(CabeceraInstantanea) + tabla.size() * sizeof(SensorInstantanea)
+                     + ejes.size() * sizeof(EjeInstantanea);
+        auto reservarSeccion = [&pos](uint64_t bytes) { uint64_t inicio = pos; pos += alinear8(bytes); return inicio; };
+
+        for (size_t i = 0; i < tabla.size(); i++) {
+            tabla[i].longitudId = sensores[i]->getId().size();
+            tabla[i].desplazamientoId = reservarSeccion(tabla[i].longitudId);
+            tabla[i].longitudUnidad = unidades[i].size();
+            tabla[i].desplazamientoUnidad = reservarSeccion(tabla[i].longitudUnidad);
+        }
+        std::vector<EjeInstantanea> tablaEjes(ejes.size());
+        for (size_t e = 0; e < ejes.size(); e++) {
+            tablaEjes[e].numTiempos = ejeRetenido[e] ? ejeRetenido[e]->getNumLecturas() : ejes[e].size();
+            tablaEjes[e].desplazamiento = reservarSeccion(tablaEjes[e].numTiempos * sizeof(int64_t));
+        }
+        std::vector<std::vector<BloqueInstantanea>> bloques(tabla.size());
+        for (size_t i = 0; i < tabla.size(); i++) {
+            const SerieComprimida* serie = sensores[i]->getSerieComprimida();
+            if (!serie) {
+                tabla[i].desplazamientoValores = reservarSeccion(tabla[i].numLecturas * sizeof(double));
+                continue;
+            }
+            tabla[i].desplazamientoBloques = reservarSeccion(tabla[i].numBloques * sizeof(BloqueInstantanea));
+            for (const BloqueComprimido& b : serie->getBloques()) {
+                BloqueInstantanea bi{};
+                bi.tiempoInicial = b.cabecera.tiempoInicial;
+                bi.tiempoFinal = b.cabecera.tiempoFinal;
+                bi.agregados = AgregadosInstantanea::desde(b.cabecera.agregados);
+                bi.tiempoPrevio = b.tiempoPrevio;
+                bi.deltaPrevio = b.deltaPrevio;
+                bi.bitsPrevios = b.bitsPrevios;
+                bi.ceroIzqPrevio = b.ceroIzqPrevio;
+                bi.ceroDerPrevio = b.ceroDerPrevio;
+                bi.bits = b.flujo.size();
+                bi.numPalabras = b.flujo.getPalabras().size();
+                bi.desplazamientoPalabras = reservarSeccion(bi.numPalabras * sizeof(uint64_t));
+                bloques[i].push_back(bi);
+            }
+        }
+        for (size_t i = 0; i < tabla.size(); i++) {
+            const BosquejoKLL& bosquejo = sensores[i]->getBosquejoCuantiles();
+            tabla[i].desplazamientoCuantiles = reservarSeccion(sizeof(CuantilesInstantanea)
+                + bosquejo.numNiveles() * sizeof(uint64_t) + bosquejo.numRetenidos() * sizeof(double));
+            if (const Histograma* h = sensores[i]->getHistograma()) {
+                tabla[i].numBordes = h->getBordes().size();
+                tabla[i].desplazamientoHistograma = reservarSeccion(tabla[i].numBordes * sizeof(double)
+                                                                    + h->numCubetas() * sizeof(uint64_t));
+            }
+        }
+
+        CabeceraInstantanea cabecera{};
+        std::memcpy(cabecera.magia, MAGIA_INSTANTANEA, 8);
+        cabecera.version = VERSION_INSTANTANEA;
+        cabecera.marcaOrden = MARCA_ORDEN_BYTES;
+        cabecera.numSensores = tabla.size();
+        cabecera.numEjes = ejes.size();
+        cabecera.tamanoArchivo = pos;
+
+        // O(n) - Escribir cabecera, tablas y secciones (cada una rellenada a 8 bytes)
+        std::string temporal = nombreArchivo + ".tmp";
+        std::ofstream salida(temporal, std::ios::binary | std::ios::trunc);
+        if (!salida.is_open()) return false;
+        auto escribir = [&salida](const void* datos, uint64_t bytes) {
+            static const char relleno[8] = {};
+            if (bytes > 0) salida.write(static_cast<const char*>(datos), static_cast<std::streamsize>(bytes));
+            salida.write(relleno, static_cast<std::streamsize>(alinear8(bytes) - bytes));
+        };
+
+        escribir(&cabecera, sizeof(cabecera));
+        escribir(tabla.data(), tabla.size() * sizeof(SensorInstantanea));
+        escribir(tablaEjes.data(), tablaEjes.size() * sizeof(EjeInstantanea));
+        for (size_t i = 0; i < tabla.size(); i++) {
+            escribir(sensores[i]->getId().data(), tabla[i].longitudId);
+            escribir(unidades[i].data(), tabla[i].longitudUnidad);
+        }
+        auto escribirTiempos = [&salida](const int64_t* datos, size_t k, size_t) {
+            salida.write(reinterpret_cast<const char*>(datos), static_cast<std::streamsize>(k * sizeof(int64_t)));
+        };
+        for (size_t e = 0; e < ejes.size(); e++) {
+            if (ejeRetenido[e]) ejeRetenido[e]->recorrerTiempos(0, tablaEjes[e].numTiempos, escribirTiempos);
+            else ejes[e].recorrerTramos(escribirTiempos);
+        }
+        for (size_t i = 0; i < tabla.size(); i++) {
+            const SerieComprimida* serie = sensores[i]->getSerieComprimida();
+            if (!serie) {
+                sensores[i]->recorrerLecturas(0, tabla[i].numLecturas, [&](const double* datos, size_t k, size_t) {
+                    salida.write(reinterpret_cast<const char*>(datos), static_cast<std::streamsize>(k * sizeof(double)));
+                });
+                continue;
+            }
+            escribir(bloques[i].data(), bloques[i].size() * sizeof(BloqueInstantanea));
+            for (const BloqueComprimido& b : serie->getBloques()) {
+                escribir(b.flujo.getPalabras().data(), b.flujo.getPalabras().size() * sizeof(uint64_t));
+            }
+        }
+        for (size_t i = 0; i < tabla.size(); i++) {
+            const BosquejoKLL& bosquejo = sensores[i]->getBosquejoCuantiles();
+            CuantilesInstantanea ci{bosquejo.getK(), bosquejo.size(), bosquejo.getMinimo(), bosquejo.getMaximo(),
+                                    bosquejo.getEstadoAleatorio(), bosquejo.numNiveles()};
+            salida.write(reinterpret_cast<const char*>(&ci), sizeof(ci));
+            for (size_t h = 0; h < bosquejo.numNiveles(); h++) {
+                uint64_t tamano = bosquejo.getNivel(h).size();
+                salida.write(reinterpret_cast<const char*>(&tamano), sizeof(tamano));
+            }
+            for (size_t h = 0; h < bosquejo.numNiveles(); h++) {
+                const std::vector<double>& nivel = bosquejo.getNivel(h);
+                salida.write(reinterpret_cast<const char*>(nivel.data()), static_cast<std::streamsize>(nivel.size() * sizeof(double)));
+            }
+            if (const Histograma* h = sensores[i]->getHistograma()) {
+                std::vector<uint64_t> conteos(h->numCubetas());
+                for (size_t c = 0; c < conteos.size(); c++) conteos[c] = h->conteo(c);
+                salida.write(reinterpret_cast<const char*>(h->getBordes().data()),
+                             static_cast<std::streamsize>(h->getBordes().size() * sizeof(double)));
+                salida.write(reinterpret_cast<const char*>(conteos.data()),
+                             static_cast<std::streamsize>(conteos.size() * sizeof(uint64_t)));
+            }
+        }
+        salida.close();
+
+        // El contenido llega a disco antes del rename y el rename antes de retornar
+        std::error_code error;
+        if (!salida || !sincronizarArchivo(temporal)) {
+            std::filesystem::remove(temporal, error);
+            return false;
+        }
+        std::filesystem::rename(temporal, nombreArchivo, error);
+        return !error && sincronizarDirectorio(nombreArchivo);
+    }
+
+    // O(n) - Cargar una instantánea sin parsear texto ni recalcular estadísticas:
+    // el archivo se mapea, las columnas se copian por segmentos y los agregados
+    // se toman de la cabecera de cada sensor. Los sensores inexistentes se crean
+    // según su tipo; uno ya registrado se restaura solo si está vacío.
+    // Retorna false si el archivo no existe o no es una instantánea válida.
+    bool cargarInstantanea(const std::string& nombreArchivo) {
+        InstantaneaMapeada instantanea(nombreArchivo);
+        if (!instantanea.valida()) return false;
+
+        // O(m) - Un eje usado por un solo sensor crudo se restaura como propio
+        std::vector<size_t> usuarios(instantanea.numEjes(), 0);
+        for (size_t i = 0; i < instantanea.numSensores(); i++) {
+            const SensorInstantanea& si = instantanea.sensor(i);
+            if (si.modo == MODO_CRUDO) usuarios[si.eje]++;
         }
+        std::vector<std::shared_ptr<EjeTiempo>> ejes(instantanea.numEjes());
+        auto construirEje = [&instantanea](size_t e, size_t n) {
+            auto eje = std::make_shared<EjeTiempo>();
+            eje->reservar(n);
+            eje->agregar(instantanea.tiemposEje(e), n);
+            return eje;
+        };
 
-        // O(l) - Procesar cada línea del archivo
-        while (std::getline(file, line)) { // O(l)
-            size_t pos1 = line.find(','); // O(k) donde k = longitud de línea
-            size_t pos2 = line.find(',', pos1+1); // O(k)
-            size_t pos3 = line.find(',', pos2+1); // O(k)
+        for (size_t i = 0; i < instantanea.numSensores(); i++) {
+            const SensorInstantanea& si = instantanea.sensor(i);
+            std::string id(instantanea.id(i));
+            Sensor* sensor = buscarSensor(id);
+            if (!sensor) {
+                std::unique_ptr<Sensor> nuevo = crearSensor(si.tipo, id, std::string(instantanea.unidad(i)));
+                if (!nuevo) continue; // tipo desconocido en esta versión
+                sensor = sensorPorManejador(agregarSensor(std::move(nuevo)));
+            }
+            if (sensor->getNumLecturas() > 0) continue;
 
-            std::string fecha = line.substr(pos1+1, pos2-pos1-1); // O(k)
-            double temperatura = std::stod(line.substr(pos2+1, pos3-pos2-1)); // O(k)
-            double humedad = std::stod(line.substr(pos3+1)); // O(k)
+            size_t n = static_cast<size_t>(si.numLecturas);
+            Agregados agregadosSensor = instantanea.agregados(i);
+            if (si.modo == MODO_COMPRIMIDO) {
+                std::vector<BloqueComprimido> bloques(static_cast<size_t>(si.numBloques));
+                const BloqueInstantanea* guardados = instantanea.bloques(i);
+                for (size_t j = 0; j < bloques.size(); j++) {
+                    const BloqueInstantanea& bi = guardados[j];
+                    const uint64_t* palabras = instantanea.palabras(bi);
+                    BloqueComprimido& b = bloques[j];
+                    b.cabecera.tiempoInicial = bi.tiempoInicial;
+                    b.cabecera.tiempoFinal = bi.tiempoFinal;
+                    b.cabecera.agregados = bi.agregados.comoAgregados();
+                    b.flujo = FlujoBits::desdePalabras(std::vector<uint64_t>(palabras, palabras + bi.numPalabras),
+                                                       static_cast<size_t>(bi.bits));
+                    b.tiempoPrevio = bi.tiempoPrevio;
+                    b.deltaPrevio = bi.deltaPrevio;
+                    b.bitsPrevios = bi.bitsPrevios;
+                    b.ceroIzqPrevio = bi.ceroIzqPrevio;
+                    b.ceroDerPrevio = bi.ceroDerPrevio;
+                }
+                auto serie = std::make_unique<SerieComprimida>(
+                    SerieComprimida::desdeBloques(static_cast<size_t>(si.puntosPorBloque), std::move(bloques)));
+                if (sensor->restaurarComprimida(std::move(serie), agregadosSensor)) restaurarResumenes(instantanea, i, *sensor);
+                continue;
+            }
 
-            // O(1) - Buscar sensores (m es pequeño, normalmente 2)
-            if (auto sensorTemp = buscarSensor("TEMP_001")) {
-                sensorTemp->agregarLectura(temperatura, fecha); // O(1)
+            bool compartido = si.modo == MODO_CRUDO && usuarios[si.eje] > 1;
+            std::shared_ptr<EjeTiempo> eje;
+            if (compartido) {
+                if (!ejes[si.eje]) ejes[si.eje] = construirEje(si.eje, instantanea.eje(si.eje).numTiempos);
+                eje = ejes[si.eje];
+            } else {
+                eje = construirEje(si.eje, n);
+            }
+            if (!sensor->restaurarLecturas(eje, compartido, instantanea.valores(i), n, agregadosSensor)) continue;
+            if (si.modo == MODO_RETENCION) {
+                sensor->activarRetencion(PoliticaRetencion{static_cast<size_t>(si.capacidadRetencion), si.ventanaSegundos});
             }
+            restaurarResumenes(instantanea, i, *sensor);
+        }
+        return true;
+    }
+
+    // O(r + m) - Activar el WAL: primero se reproduce lo que ya tenga el archivo
+    // (creando los sensores declarados que no existan) y luego cada lectura que
+    // llegue a cualquier sensor se anota antes de aplicarse. Llamar después de
+    // cargar el CSV o la instantánea base: lo que se cargue con el WAL activo
+    // también queda anotado. Retorna false si ya estaba activo, si el archivo
+    // no es un registro o no se pudo abrir.
+    bool activarRegistro(const std::string& nombreArchivo,
+                         ConfiguracionRegistro config = ConfiguracionRegistro()) {
+        if (registro) return false;
+        auto wal = std::make_unique<RegistroEscrituraAnticipada>(config);
+
+        // O(r) - Reproducir: cada canal se resuelve a su sensor una sola vez
+        std::vector<Sensor*> sensorPorCanal;
+        int64_t bytesValidos = RegistroEscrituraAnticipada::reproducir(nombreArchivo,
+            [&](uint32_t canal, uint32_t tipo, std::string_view id, std::string_view unidad) {
+                Sensor* sensor = buscarSensor(id);
+                if (!sensor) {
+                    std::unique_ptr<Sensor> nuevo = crearSensor(tipo, std::string(id), std::string(unidad));
+                    if (nuevo) sensor = sensorPorManejador(agregarSensor(std::move(nuevo)));
+                }
+                if (sensorPorCanal.size() <= canal) sensorPorCanal.resize(canal + 1, nullptr);
+                sensorPorCanal[canal] = sensor;
+                wal->recordarCanal(id, canal);
+            },
+            [&](uint32_t canal, int64_t tiempo, double valor) {
+                if (canal < sensorPorCanal.size() && sensorPorCanal[canal]) {
+                    sensorPorCanal[canal]->agregarLectura(valor, tiempo);
+                }
+            });
+        if (!wal->abrir(nombreArchivo, bytesValidos)) return false;
+
+        registro = std::move(wal);
+        for (auto& sensor : sensores) enlazarConRegistro(*sensor);
+        return true;
+    }
+
+    // O(lote) - Esperar a que todas las lecturas anotadas sean durables
+    bool confirmarRegistro() { return registro && registro->confirmar(); }
+
+    // O(n) - Punto de control: guardar la instantánea y, si se escribió, recortar
+    // el WAL (sus lecturas ya están en la instantánea)
+    bool puntoDeControl(const std::string& nombreInstantanea) {
+        if (!registro || !registro->confirmar()) return false;
+        if (!guardarInstantanea(nombreInstantanea)) return false;
+        return registro->reiniciar([this] {
+            for (auto& sensor : sensores) enlazarConRegistro(*sensor);
+        });
+    }
+
+private:
+    // O(1) - Código de tipo (y unidad) con el que se guarda un sensor
+    static uint32_t tipoDeSensor(const Sensor& sensor, std::string& unidad) {
+        if (auto temperatura = dynamic_cast<const SensorTemperatura*>(&sensor)) {
+            unidad = temperatura->getUnidad();
+            return TIPO_TEMPERATURA;
+        }
+        if (dynamic_cast<const SensorHumedad*>(&sensor)) return TIPO_HUMEDAD;
+        return TIPO_DESCONOCIDO;
+    }
+
+    // O(|id|) - Declarar el sensor en el WAL (si es nuevo) y enlazar su canal
+    void enlazarConRegistro(Sensor& sensor) {
+        std::string unidad;
+        uint32_t tipo = tipoDeSensor(sensor, unidad);
+        sensor.enlazarRegistro(registro.get(), registro->declararSensor(sensor.getId(), tipo, unidad));
+    }
+
+    // O(H + r + m) - Reponer en un sensor recién restaurado los resúmenes de todo
+    // lo recibido que guardó la instantánea (con retención incluyen lo expulsado)
+    static void restaurarResumenes(const InstantaneaMapeada& instantanea, size_t i, Sensor& sensor) {
+        sensor.restaurarCuantiles(instantanea.cuantiles(i));
+        if (instantanea.tieneHistograma(i)) {
+            const double* bordes = instantanea.bordesHistograma(i);
+            sensor.restaurarHistograma(std::vector<double>(bordes, bordes + instantanea.sensor(i).numBordes),
+                                       instantanea.conteosHistograma(i));
+        }
+    }
+
+    // O(1) - Crear un sensor vacío a partir del tipo guardado (instantánea o WAL)
+    static std::unique_ptr<Sensor> crearSensor(uint32_t tipo, const std::string& id, const std::string& unidad) {
+        if (tipo == TIPO_TEMPERATURA) return std::make_unique<SensorTemperatura>(id, unidad);
+        if (tipo == TIPO_HUMEDAD) return std::make_unique<SensorHumedad>(id);
+        return nullptr;
+    }
+
+    // Destino de una columna durante la carga: el sensor y si usa el eje del archivo
+    struct CanalCarga {
+        Sensor* sensor = nullptr;
+        bool enEje = false;
 
-            if (auto sensorHum = buscarSensor("HUM_001")) {
-                sensorHum->agregarLectura(humedad, fecha); // O(1)
+        // O(1) - Con eje compartido la marca ya fue agregada una vez por fila
+        void agregar(double valor, int64_t timestamp) {
+            if (enEje) sensor->agregarLecturaEnEje(valor);
+            else sensor->agregarLectura(valor, timestamp);
+        }
+    };
+
+    // O(c + e) - Leer el encabezado una vez y resolver cada columna enlazada a un
+    // canal (c = columnas, e = enlaces configurados). Los sensores vacíos se
+    // enlazan al eje del archivo; uno con lecturas previas conserva su propio eje.
+    // Retorna false si el encabezado no tiene la columna de fecha o si dos enlaces
+    // apuntan al mismo sensor (los dos tomarían el eje compartido y el segundo
+    // leería marcas que el eje aún no tiene).
+    bool enlazarColumnas(std::string_view encabezado, const std::shared_ptr<EjeTiempo>& eje,
+                         PlanColumnas& plan, std::vector<CanalCarga>& canales) {
+        std::vector<std::string_view> nombres;
+        recorrerFilas(encabezado.substr(0, encabezado.find('\n')), [&](const std::vector<std::string_view>& campos) {
+            nombres = campos;
+        });
+
+        std::unordered_map<std::string_view, size_t> columnaPorNombre;
+        for (size_t c = 0; c < nombres.size(); c++) columnaPorNombre.emplace(nombres[c], c);
+
+        auto fecha = columnaPorNombre.find(configuracionCSV.columnaFecha);
+        if (fecha == columnaPorNombre.end()) return false;
+        if (!ConfiguracionCSV::sensoresUnicos(configuracionCSV.enlaces)) return false;
+        plan.columnaFecha = fecha->second;
+        plan.camposMinimos = fecha->second + 1;
+
+        for (const auto& enlace : configuracionCSV.enlaces) {
+            auto columna = columnaPorNombre.find(enlace.columna);
+            if (columna == columnaPorNombre.end()) continue; // columna ausente en este archivo
+
+            Sensor* sensor = buscarSensor(enlace.idSensor);
+            if (!sensor && enlace.crear) {
+                sensor = sensorPorManejador(agregarSensor(enlace.crear(enlace.idSensor)));
             }
+            if (!sensor) continue;
+
+            CanalCarga canal;
+            canal.sensor = sensor;
+            canal.enEje = sensor->compartirEje(eje);
+            canales.push_back(canal);
+            plan.columnasValor.push_back(columna->second);
+            plan.camposMinimos = std::max(plan.camposMinimos, columna->second + 1);
         }
-        file.close();
         return true;
     }
+
+    // O(c) - Ciclo por fila sin búsquedas: la fecha va una vez al eje y cada
+    // canal recibe el valor de su columna ya resuelta. La fila se parsea completa
+    // en 'fila' (un valor por canal) antes de aplicarla: si un campo no es válido
+    // se descarta entera (ver parsearFila)
+    static void procesarFila(const std::vector<std::string_view>& campos, const PlanColumnas& plan,
+                             EjeTiempo& eje, std::vector<CanalCarga>& canales, std::vector<double>& fila) {
+        int64_t fecha;
+        if (!parsearFila(campos, plan, fecha, fila.data())) return; // O(c)
+        eje.agregar(fecha);
+        for (size_t k = 0; k < canales.size(); k++) canales[k].agregar(fila[k], fecha); // O(1)
+    }
 };
 
 #endif // SENSORES_H
\ No newline at end of file
@@ -0,0 +1,419 @@
+#ifndef SERIECOMPRIMIDA_H
+#define SERIECOMPRIMIDA_H
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+#include <iterator>
+#include <algorithm>
+#include "Estadisticas.h"
+
+// Compresión estilo Gorilla (Pelkonen et al., VLDB 2015) para series de sensores:
+// - Tiempos: delta de deltas con prefijos de longitud variable (1 bit si el
+//   muestreo es regular).
+// - Valores: XOR con el valor anterior; solo se guardan los bits significativos.
+// La serie se divide en bloques de tamaño fijo, cada uno con una cabecera
+// (primer/último tiempo y agregados) que permite responder consultas sin
+// descomprimir y decodificar un bloque de forma independiente.
+
+// O(1) - Conteo de ceros a la izquierda / derecha (x != 0)
+inline unsigned cerosIzquierda64(uint64_t x) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long i; _BitScanReverse64(&i, x); return 63 - static_cast<unsigned>(i);
+#else
+    return static_cast<unsigned>(__builtin_clzll(x));
+#endif
+}
+inline unsigned cerosDerecha64(uint64_t x) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long i; _BitScanForward64(&i, x); return static_cast<unsigned>(i);
+#else
+    return static_cast<unsigned>(__builtin_ctzll(x));
+#endif
+}
+
+// Flujo de bits (escritura al final, lectura secuencial)
+class FlujoBits {
+private:
+    std::vector<uint64_t> palabras;
+    size_t bits = 0;
+
+public:
+    // O(1) - Escribir los 'n' bits menos significativos de 'valor' (1 <= n <= 64)
+    void escribir(uint64_t valor, unsigned n) {
+        if (n < 64) valor &= (uint64_t(1) << n) - 1;
+        size_t desplazamiento = bits % 64;
+        if (desplazamiento == 0) palabras.push_back(0);
+        palabras.back() |= valor << desplazamiento;
+        if (desplazamiento + n > 64) palabras.push_back(valor >> (64 - desplazamiento));
+        bits += n;
+    }
+
+    // O(1) - Leer 'n' bits a partir de la posición 'pos' (que se avanza)
+    uint64_t leer(size_t& pos, unsigned n) const { return leer(palabras.data(), pos, n); }
+
+    // O(1) - Igual sobre palabras externas (p. ej. mapeadas). Precondición: pos + n
+    // no pasa del último bit de 'datos'
+    static uint64_t leer(const uint64_t* datos, size_t& pos, unsigned n) {
+        size_t palabra = pos / 64, desplazamiento = pos % 64;
+        uint64_t valor = datos[palabra] >> desplazamiento;
+        if (desplazamiento + n > 64) valor |= datos[palabra + 1] << (64 - desplazamiento);
+        if (n < 64) valor &= (uint64_t(1) << n) - 1;
+        pos += n;
+        return valor;
+    }
+
+    size_t size() const { return bits; }                                   // O(1)
+    size_t bytes() const { return palabras.size() * sizeof(uint64_t); }    // O(1)
+    const std::vector<uint64_t>& getPalabras() const { return palabras; }  // O(1)
+    void reducir() { palabras.shrink_to_fit(); }                           // O(p)
+
+    // O(p) - Reconstruir desde palabras ya codificadas (instantáneas)
+    static FlujoBits desdePalabras(std::vector<uint64_t> palabras, size_t bits) {
+        FlujoBits f;
+        f.palabras = std::move(palabras);
+        f.bits = bits;
+        return f;
+    }
+};
+
+// Cabecera de un bloque comprimido
+struct CabeceraBloque {
+    int64_t tiempoInicial = 0;
+    int64_t tiempoFinal = 0;
+    Agregados agregados; // índices absolutos dentro de la serie
+};
+
+// Bloque comprimido: cabecera + flujo de bits + estado del codificador
+struct BloqueComprimido {
+    CabeceraBloque cabecera;
+    FlujoBits flujo;
+
+    // Estado del codificador (solo necesario mientras el bloque está abierto)
+    int64_t tiempoPrevio = 0;
+    int64_t deltaPrevio = 0;
+    uint64_t bitsPrevios = 0;
+    unsigned ceroIzqPrevio = 65; // 65 = aún no hay ventana de bits significativos
+    unsigned ceroDerPrevio = 0;
+
+    size_t size() const { return cabecera.agregados.n; } // O(1)
+};
+
+// Punto decodificado de la serie
+struct PuntoSerie {
+    int64_t tiempo;
+    double valor;
+};
+
+class SerieComprimida {
+private:
+    std::vector<BloqueComprimido> bloques;
+    size_t puntosPorBloque;
+    size_t total = 0;
+    bool ordenada = true; // ningún tiempo retrocede: primer/último tiempo acotan cada bloque
+
+    static uint64_t bitsDe(double v) { uint64_t b; std::memcpy(&b, &v, 8); return b; }
+    static double deBits(uint64_t b) { double v; std::memcpy(&v, &b, 8); return v; }
+
+    // O(1) - Delta de deltas con zigzag: '0' | '10'+7 | '110'+9 | '1110'+12 | '1111'+64
+    static void codificarTiempo(BloqueComprimido& b, int64_t tiempo) {
+        int64_t delta = tiempo - b.tiempoPrevio;
+        int64_t dd = delta - b.deltaPrevio;
+        uint64_t zz = (static_cast<uint64_t>(dd) << 1) ^ static_cast<uint64_t>(dd >> 63);
+        if (zz == 0)              b.flujo.escribir(0b0, 1);
+        else if (zz < (1u << 7))  { b.flujo.escribir(0b01, 2);   b.flujo.escribir(zz, 7); }
+        else if (zz < (1u << 9))  { b.flujo.escribir(0b011, 3);  b.flujo.escribir(zz, 9); }
+        else if (zz < (1u << 12)) { b.flujo.escribir(0b0111, 4); b.flujo.escribir(zz, 12); }
+        else                      { b.flujo.escribir(0b1111, 4); b.flujo.escribir(zz, 64); }
+        b.deltaPrevio = delta;
+        b.tiempoPrevio = tiempo;
+    }
+
+    // O(1) - XOR con el valor previo: '0' igual | '10' misma ventana | '11'+5+6 nueva ventana
+    static void codificarValor(BloqueComprimido& b, double valor) {
+        uint64_t bits = bitsDe(valor);
+        uint64_t x = bits ^ b.bitsPrevios;
+        b.bitsPrevios = bits;
+        if (x == 0) { b.flujo.escribir(0b0, 1); return; }
+
+        unsigned izq = std::min(cerosIzquierda64(x), 31u);
+        unsigned der = cerosDerecha64(x);
+        if (b.ceroIzqPrevio <= 64 && izq >= b.ceroIzqPrevio && der >= b.ceroDerPrevio) {
+            b.flujo.escribir(0b01, 2);
+            b.flujo.escribir(x >> b.ceroDerPrevio, 64 - b.ceroIzqPrevio - b.ceroDerPrevio);
+            return;
+        }
+        unsigned significativos = 64 - izq - der;
+        b.flujo.escribir(0b11, 2);
+        b.flujo.escribir(izq, 5);
+        b.flujo.escribir(significativos & 63, 6); // 64 se guarda como 0
+        b.flujo.escribir(x >> der, significativos);
+        b.ceroIzqPrevio = izq;
+        b.ceroDerPrevio = der;
+    }
+
+public:
+    // Decodificador secuencial de un bloque
+    class LectorBloque {
+    private:
+        const BloqueComprimido* bloque = nullptr;
+        size_t pos = 0;
+        size_t leidos = 0;
+        int64_t tiempo = 0, delta = 0;
+        uint64_t bits = 0;
+        unsigned izq = 0, der = 0;
+
+    public:
+        LectorBloque() = default;
+        explicit LectorBloque(const BloqueComprimido& b) : bloque(&b) {}
+
+        // O(1) - Decodificar el siguiente punto; false al terminar el bloque
+        bool siguiente(PuntoSerie& punto) {
+            if (!bloque || leidos == bloque->size()) return false;
+            const FlujoBits& f = bloque->flujo;
+            if (leidos == 0) {
+                tiempo = static_cast<int64_t>(f.leer(pos, 64));
+                bits = f.leer(pos, 64);
+            } else {
+                uint64_t zz;
+                if (f.leer(pos, 1) == 0) zz = 0;
+                else if (f.leer(pos, 1) == 0) zz = f.leer(pos, 7);
+                else if (f.leer(pos, 1) == 0) zz = f.leer(pos, 9);
+                else if (f.leer(pos, 1) == 0) zz = f.leer(pos, 12);
+                else zz = f.leer(pos, 64);
+                int64_t dd = static_cast<int64_t>(zz >> 1) ^ -static_cast<int64_t>(zz & 1);
+                // Sumas en módulo 2^64: un flujo bien formado pero con deltas extremos
+                // (p. ej. una instantánea dañada) no desborda con signo
+                delta = static_cast<int64_t>(static_cast<uint64_t>(delta) + static_cast<uint64_t>(dd));
+                tiempo = static_cast<int64_t>(static_cast<uint64_t>(tiempo) + static_cast<uint64_t>(delta));
+
+                if (f.leer(pos, 1) == 1) {
+                    if (f.leer(pos, 1) == 1) {
+                        izq = static_cast<unsigned>(f.leer(pos, 5));
+                        unsigned significativos = static_cast<unsigned>(f.leer(pos, 6));
+                        if (significativos == 0) significativos = 64;
+                        der = 64 - izq - significativos;
+                    }
+                    bits ^= f.leer(pos, 64 - izq - der) << der;
+                }
+            }
+            leidos++;
+            punto.tiempo = tiempo;
+            punto.valor = deBits(bits);
+            return true;
+        }
+    };
+
+    // Iterador de entrada que decodifica la serie completa en orden
+    class Iterador {
+    private:
+        const SerieComprimida* serie = nullptr;
+        size_t bloque = 0;
+        size_t indice = 0;
+        LectorBloque lector;
+        PuntoSerie actual{0, 0.0};
+
+        void avanzar() {
+            while (bloque < serie->bloques.size()) {
+                if (lector.siguiente(actual)) return;
+                if (++bloque < serie->bloques.size()) lector = LectorBloque(serie->bloques[bloque]);
+            }
+        }
+
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = PuntoSerie;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const PuntoSerie*;
+        using reference = const PuntoSerie&;
+
+        Iterador(const SerieComprimida* serie, size_t indice) : serie(serie), indice(indice) {
+            if (indice == 0 && !serie->bloques.empty()) {
+                lector = LectorBloque(serie->bloques[0]);
+                avanzar();
+            }
+        }
+
+        reference operator*() const { return actual; }
+        pointer operator->() const { return &actual; }
+        Iterador& operator++() { indice++; avanzar(); return *this; }
+        bool operator==(const Iterador& otro) const { return indice == otro.indice; }
+        bool operator!=(const Iterador& otro) const { return indice != otro.indice; }
+    };
+
+    // O(1) - Bloques de 1K puntos por defecto (se recomiendan entre 1K y 4K)
+    explicit SerieComprimida(size_t puntosPorBloque = 1024)
+        : puntosPorBloque(puntosPorBloque == 0 ? 1024 : puntosPorBloque) {}
+
+    // O(b) - Reconstruir una serie a partir de bloques ya codificados (instantáneas)
+    // Precondición: todos los bloques salvo el último tienen puntosPorBloque puntos
+    static SerieComprimida desdeBloques(size_t puntosPorBloque, std::vector<BloqueComprimido> bloques) {
+        SerieComprimida serie(puntosPorBloque);
+        serie.bloques = std::move(bloques);
+        for (const auto& b : serie.bloques) serie.total += b.size();
+        // El orden no va en el formato: se verifica decodificando los tiempos
+        int64_t anterior = 0;
+        size_t k = 0;
+        for (auto it = serie.begin(); it != serie.end() && serie.ordenada; ++it, ++k) {
+            if (k > 0 && it->tiempo < anterior) serie.ordenada = false;
+            anterior = it->tiempo;
+        }
+        return serie;
+    }
+
+    // O(n) - Verificar que los 'bits' bits de 'palabras' codifican exactamente n
+    // puntos, recorriendo los prefijos sin reconstruir valores (datos externos,
+    // p. ej. instantáneas): ninguna lectura pasa del flujo y ninguna ventana de
+    // bits significativos excede 64. Si se cumple, LectorBloque no lee fuera
+    static bool flujoValido(const uint64_t* palabras, size_t bits, size_t n) {
+        static constexpr unsigned CARGA_TIEMPO[] = {0, 7, 9, 12, 64}; // por cantidad de unos del prefijo
+        size_t pos = 0;
+        uint64_t x = 0;
+        auto leer = [&](unsigned k) {
+            if (k > bits - pos) return false;
+            x = FlujoBits::leer(palabras, pos, k);
+            return true;
+        };
+        if (n == 0) return bits == 0;
+        if (!leer(64) || !leer(64)) return false;
+        unsigned izq = 0, der = 0;
+        for (size_t i = 1; i < n; i++) {
+            unsigned unos = 0;
+            while (unos < 4) {
+                if (!leer(1)) return false;
+                if (x == 0) break;
+                unos++;
+            }
+            if (unos > 0 && !leer(CARGA_TIEMPO[unos])) return false;
+            if (!leer(1)) return false;
+            if (x == 0) continue; // mismo valor
+            if (!leer(1)) return false;
+            if (x == 1) {
+                if (!leer(5)) return false;
+                unsigned nuevoIzq = static_cast<unsigned>(x);
+                if (!leer(6)) return false;
+                unsigned significativos = x == 0 ? 64 : static_cast<unsigned>(x);
+                if (nuevoIzq + significativos > 64) return false;
+                izq = nuevoIzq;
+                der = 64 - izq - significativos;
+            }
+            if (!leer(64 - izq - der)) return false;
+        }
+        return pos == bits;
+    }
+
+    // O(1) amortizado - Agregar un punto al bloque abierto
+    void agregar(int64_t tiempo, double valor) {
+        if (total > 0 && tiempo < bloques.back().cabecera.tiempoFinal) ordenada = false;
+        if (bloques.empty() || bloques.back().size() == puntosPorBloque) {
+            if (!bloques.empty()) bloques.back().flujo.reducir(); // bloque sellado
+            bloques.emplace_back();
+            BloqueComprimido& nuevo = bloques.back();
+            nuevo.flujo.escribir(static_cast<uint64_t>(tiempo), 64);
+            nuevo.flujo.escribir(bitsDe(valor), 64);
+            nuevo.tiempoPrevio = tiempo;
+            nuevo.bitsPrevios = bitsDe(valor);
+            nuevo.cabecera.tiempoInicial = tiempo;
+        } else {
+            codificarTiempo(bloques.back(), tiempo);
+            codificarValor(bloques.back(), valor);
+        }
+        BloqueComprimido& b = bloques.back();
+        b.cabecera.tiempoFinal = tiempo;
+        b.cabecera.agregados.agregar(valor, total);
+        total++;
+    }
+
+    // O(B) - Punto en la posición i (decodifica solo su bloque)
+    PuntoSerie punto(size_t i) const {
+        LectorBloque lector(bloques[i / puntosPorBloque]);
+        PuntoSerie p{0, 0.0};
+        for (size_t k = 0; k <= i % puntosPorBloque; k++) lector.siguiente(p);
+        return p;
+    }
+
+    // O(log b + B) - Primera posición con tiempo >= t (size() si no hay): bisección
+    // sobre el último tiempo de cada bloque y decodificación de uno solo.
+    // Precondición: estaOrdenada()
+    size_t primeraNoMenor(int64_t t) const {
+        auto it = std::partition_point(bloques.begin(), bloques.end(),
+                                       [&](const BloqueComprimido& b) { return b.cabecera.tiempoFinal < t; });
+        if (it == bloques.end()) return total;
+        size_t indice = static_cast<size_t>(it - bloques.begin()) * puntosPorBloque;
+        LectorBloque lector(*it);
+        PuntoSerie p{0, 0.0};
+        while (lector.siguiente(p) && p.tiempo < t) indice++;
+        return indice;
+    }
+
+    // O(j - i + B) - Decodificar los puntos [i, j) bloque a bloque en un búfer de B
+    // puntos y entregarlos por tramos: f(tiempos, valores, longitud, inicio)
+    template <typename F>
+    void recorrerTramos(size_t i, size_t j, F f) const {
+        j = std::min(j, total);
+        if (i >= j) return;
+        std::vector<int64_t> tiempos(std::min(puntosPorBloque, j - i));
+        std::vector<double> valores(tiempos.size());
+        for (size_t b = i / puntosPorBloque; b * puntosPorBloque < j; b++) {
+            size_t indice = b * puntosPorBloque, k = 0;
+            LectorBloque lector(bloques[b]);
+            PuntoSerie p{0, 0.0};
+            while (indice < j && lector.siguiente(p)) {
+                if (indice++ < i) continue;
+                tiempos[k] = p.tiempo;
+                valores[k] = p.valor;
+                k++;
+            }
+            f(tiempos.data(), valores.data(), k, indice - k);
+        }
+    }
+
+    // O(log b + bloques del rango) ordenada, O(n) si no - Agregados de los puntos con
+    // tiempo en [t0, t1) (índices absolutos). Los bloques contenidos en el rango
+    // aportan su cabecera; solo se decodifican los de los bordes
+    Agregados agregadosEnRango(int64_t t0, int64_t t1) const {
+        Agregados r;
+        if (t0 >= t1) return r;
+        auto desde = bloques.begin(), hasta = bloques.end();
+        if (ordenada) {
+            desde = std::partition_point(bloques.begin(), bloques.end(),
+                                         [&](const BloqueComprimido& b) { return b.cabecera.tiempoFinal < t0; });
+            hasta = std::partition_point(desde, bloques.end(),
+                                         [&](const BloqueComprimido& b) { return b.cabecera.tiempoInicial < t1; });
+        }
+        for (auto it = desde; it != hasta; ++it) {
+            const CabeceraBloque& c = it->cabecera;
+            if (ordenada && c.tiempoInicial >= t0 && c.tiempoFinal < t1) {
+                r.combinar(c.agregados);
+                continue;
+            }
+            size_t indice = static_cast<size_t>(it - bloques.begin()) * puntosPorBloque;
+            LectorBloque lector(*it);
+            PuntoSerie p{0, 0.0};
+            while (lector.siguiente(p)) {
+                if (ordenada && p.tiempo >= t1) break;
+                if (p.tiempo >= t0 && p.tiempo < t1) r.agregar(p.valor, indice);
+                indice++;
+            }
+        }
+        return r;
+    }
+
+    Iterador begin() const { return Iterador(this, 0); }      // O(1) + primer punto
+    Iterador end() const { return Iterador(this, total); }    // O(1)
+
+    size_t size() const { return total; }                              // O(1)
+    size_t getPuntosPorBloque() const { return puntosPorBloque; }      // O(1)
+    bool estaOrdenada() const { return ordenada; }                     // O(1)
+    const std::vector<BloqueComprimido>& getBloques() const { return bloques; } // O(1)
+
+    // O(b) - Memoria ocupada por los flujos de bits y las cabeceras
+    size_t bytes() const {
+        size_t b = 0;
+        for (const auto& bloque : bloques) b += bloque.flujo.bytes() + sizeof(BloqueComprimido);
+        return b;
+    }
+};
+
+#endif
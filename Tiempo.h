@@ -0,0 +1,114 @@
+#ifndef TIEMPO_H
+#define TIEMPO_H
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+
+// Marcas de tiempo como segundos desde la época (1970-01-01 00:00:00).
+// Las fechas del CSV no traen zona horaria: se tratan como hora civil sin
+// ajustes, así que parsear y formatear son inversas exactas.
+
+// O(1) - Días desde 1970-01-01 para una fecha del calendario gregoriano
+// (algoritmo days_from_civil de H. Hinnant, válido para cualquier año)
+inline int64_t diasDesdeEpoca(int64_t anio, unsigned mes, unsigned dia) {
+    anio -= mes <= 2;
+    const int64_t era = (anio >= 0 ? anio : anio - 399) / 400;
+    const unsigned anioEra = static_cast<unsigned>(anio - era * 400);
+    const unsigned diaAnio = (153 * (mes > 2 ? mes - 3 : mes + 9) + 2) / 5 + dia - 1;
+    const unsigned diaEra = anioEra * 365 + anioEra / 4 - anioEra / 100 + diaAnio;
+    return era * 146097 + static_cast<int64_t>(diaEra) - 719468;
+}
+
+// O(1) - Inversa de diasDesdeEpoca (civil_from_days)
+inline void fechaDesdeDias(int64_t dias, int64_t& anio, unsigned& mes, unsigned& dia) {
+    dias += 719468;
+    const int64_t era = (dias >= 0 ? dias : dias - 146096) / 146097;
+    const unsigned diaEra = static_cast<unsigned>(dias - era * 146097);
+    const unsigned anioEra = (diaEra - diaEra / 1460 + diaEra / 36524 - diaEra / 146096) / 365;
+    const unsigned diaAnio = diaEra - (365 * anioEra + anioEra / 4 - anioEra / 100);
+    const unsigned mp = (5 * diaAnio + 2) / 153;
+    dia = diaAnio - (153 * mp + 2) / 5 + 1;
+    mes = mp < 10 ? mp + 3 : mp - 9;
+    anio = static_cast<int64_t>(anioEra) + era * 400 + (mes <= 2);
+}
+
+// O(1) - Días del mes (año gregoriano: bisiesto si divisible por 4, salvo
+// los seculares no divisibles por 400)
+inline unsigned diasDelMes(int64_t anio, unsigned mes) {
+    static constexpr unsigned dias[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    bool bisiesto = anio % 4 == 0 && (anio % 100 != 0 || anio % 400 == 0);
+    return mes == 2 && bisiesto ? 29 : dias[mes - 1];
+}
+
+// O(1) - Parser de formato fijo "AAAA-MM-DD HH:MM:SS" (también acepta 'T')
+// Retorna false si el campo no tiene exactamente ese formato o la fecha no
+// existe (p. ej. 2025-02-31 o segundo 60): no se normaliza a otro instante.
+inline bool parsearFechaHora(std::string_view texto, int64_t& segundos) {
+    if (texto.size() != 19) return false;
+    const char* p = texto.data();
+    if (p[4] != '-' || p[7] != '-' || (p[10] != ' ' && p[10] != 'T') || p[13] != ':' || p[16] != ':') {
+        return false;
+    }
+    static constexpr int posicionesDigitos[] = {0, 1, 2, 3, 5, 6, 8, 9, 11, 12, 14, 15, 17, 18};
+    for (int i : posicionesDigitos) {
+        if (static_cast<unsigned>(p[i] - '0') > 9) return false;
+    }
+    auto dos = [p](int i) { return static_cast<unsigned>((p[i] - '0') * 10 + (p[i + 1] - '0')); };
+
+    int64_t anio = dos(0) * 100 + dos(2);
+    unsigned mes = dos(5), dia = dos(8);
+    unsigned hora = dos(11), minuto = dos(14), segundo = dos(17);
+    if (mes < 1 || mes > 12 || dia < 1 || hora > 23 || minuto > 59 || segundo > 59) return false;
+    if (dia > diasDelMes(anio, mes)) return false;
+    segundos = diasDesdeEpoca(anio, mes, dia) * 86400 + hora * 3600 + minuto * 60 + segundo;
+    return true;
+}
+
+// O(1) - Segundos transcurridos desde la medianoche del mismo día
+inline int64_t segundosDelDia(int64_t segundos) {
+    int64_t r = segundos % 86400;
+    return r < 0 ? r + 86400 : r;
+}
+
+// O(1) - Medianoche del día que contiene 'segundos'
+inline int64_t inicioDelDia(int64_t segundos) {
+    return segundos - segundosDelDia(segundos);
+}
+
+// O(1) - "HH:MM" (formateo solo en el borde de salida)
+inline std::string formatearHora(int64_t segundos) {
+    int64_t s = segundosDelDia(segundos);
+    char texto[6] = {
+        static_cast<char>('0' + s / 36000), static_cast<char>('0' + s / 3600 % 10), ':',
+        static_cast<char>('0' + s / 600 % 6), static_cast<char>('0' + s / 60 % 10), '\0'
+    };
+    return std::string(texto, 5);
+}
+
+// O(1) - "AAAA-MM-DD HH:MM:SS". El año lleva ceros a la izquierda hasta 4
+// dígitos, así parsearFechaHora acepta de vuelta cualquier año entre 0 y 9999
+inline std::string formatearFechaHora(int64_t segundos) {
+    int64_t anio;
+    unsigned mes, dia;
+    fechaDesdeDias(inicioDelDia(segundos) / 86400, anio, mes, dia);
+    int64_t s = segundosDelDia(segundos);
+
+    char anioTexto[24];
+    std::snprintf(anioTexto, sizeof(anioTexto), "%04lld", static_cast<long long>(anio));
+    std::string texto = anioTexto;
+    auto dos = [&texto](int64_t v, char sep) {
+        texto += sep;
+        texto += static_cast<char>('0' + v / 10);
+        texto += static_cast<char>('0' + v % 10);
+    };
+    dos(mes, '-');
+    dos(dia, '-');
+    dos(s / 3600, ' ');
+    dos(s / 60 % 60, ':');
+    dos(s % 60, ':');
+    return texto;
+}
+
+#endif
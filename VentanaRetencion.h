@@ -0,0 +1,196 @@
+#ifndef VENTANARETENCION_H
+#define VENTANARETENCION_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+#include "Estadisticas.h"
+
+// BufferCircular - Cola de capacidad fija reservada al construir
+// Agregar al final y quitar del frente (o del final) son O(1) y nunca realocan.
+template <typename T>
+class BufferCircular {
+private:
+    std::vector<T> datos;
+    size_t inicio = 0;
+    size_t n = 0;
+
+public:
+    explicit BufferCircular(size_t capacidad = 0) : datos(capacidad) {}
+
+    // O(1) - Precondición: !lleno()
+    void push_back(const T& valor) {
+        size_t pos = inicio + n;
+        if (pos >= datos.size()) pos -= datos.size();
+        datos[pos] = valor;
+        n++;
+    }
+
+    void pop_front() { if (++inicio == datos.size()) inicio = 0; n--; } // O(1)
+    void pop_back() { n--; }                                              // O(1)
+
+    // O(1) - Posición lógica i (0 = más antiguo)
+    const T& operator[](size_t i) const {
+        size_t pos = inicio + i;
+        return datos[pos >= datos.size() ? pos - datos.size() : pos];
+    }
+
+    // O(j - i) - Recorrer las posiciones lógicas [i, j) por tramos contiguos (a lo
+    // sumo dos, si el tramo da la vuelta): f(datos, longitud, inicio)
+    template <typename F>
+    void recorrerTramos(size_t i, size_t j, F f) const {
+        while (i < j) {
+            size_t pos = inicio + i;
+            if (pos >= datos.size()) pos -= datos.size();
+            size_t k = std::min(j - i, datos.size() - pos);
+            f(datos.data() + pos, k, i);
+            i += k;
+        }
+    }
+
+    const T& front() const { return (*this)[0]; }       // O(1)
+    const T& back() const { return (*this)[n - 1]; }    // O(1)
+    size_t size() const { return n; }                   // O(1)
+    bool empty() const { return n == 0; }               // O(1)
+    bool lleno() const { return n == datos.size(); }    // O(1)
+    size_t capacidad() const { return datos.size(); }   // O(1)
+};
+
+// PoliticaRetencion - Cuántas lecturas conserva un sensor de larga duración
+// 'capacidad' es obligatoria (se reserva por adelantado) y actúa como tope;
+// 'ventanaSegundos' > 0 además expulsa lo que sea más antiguo que la ventana.
+struct PoliticaRetencion {
+    size_t capacidad = 0;
+    int64_t ventanaSegundos = 0;
+};
+
+// VentanaRetencion - Últimas lecturas de un sensor en un buffer circular
+// Mínimo y máximo se mantienen con colas monótonas (de números de secuencia),
+// así siguen siendo correctos en O(1) amortizado cuando los puntos expiran.
+// La suma compensada y los momentos de Welford (al expulsar se quita el valor
+// con la inversa de Welford) se recalculan desde cero cada 'capacidad'
+// expulsiones para que los errores de las restas no se acumulen (O(1) amortizado).
+// También se cuentan los pares de puntos contiguos cuyo tiempo retrocede: sin
+// ninguno, las consultas por tiempo bisecan la ventana en lugar de recorrerla.
+class VentanaRetencion {
+private:
+    PoliticaRetencion politica;
+    BufferCircular<int64_t> tiempos;
+    BufferCircular<double> valores;
+    BufferCircular<uint64_t> colaMinimos; // secuencias con valores crecientes
+    BufferCircular<uint64_t> colaMaximos; // secuencias con valores decrecientes
+    uint64_t primeraSecuencia = 0;        // secuencia del punto más antiguo retenido
+    SumaCompensada suma;
+    MomentosWelford momentos;
+    size_t expulsionesDesdeRecalculo = 0;
+    uint64_t expulsadas = 0;
+    size_t desordenes = 0;                // pares contiguos retenidos con tiempos[i + 1] < tiempos[i]
+
+    double valorDeSecuencia(uint64_t s) const { return valores[static_cast<size_t>(s - primeraSecuencia)]; }
+
+    // O(1) amortizado - Expulsar el punto más antiguo
+    void expulsar() {
+        if (colaMinimos.front() == primeraSecuencia) colaMinimos.pop_front();
+        if (colaMaximos.front() == primeraSecuencia) colaMaximos.pop_front();
+        suma.agregar(-valores.front());
+        momentos.quitar(valores.front(), valores.size());
+        if (tiempos.size() > 1 && tiempos[1] < tiempos[0]) desordenes--;
+        tiempos.pop_front();
+        valores.pop_front();
+        primeraSecuencia++;
+        expulsadas++;
+
+        if (++expulsionesDesdeRecalculo >= valores.capacidad()) {
+            suma = SumaCompensada();
+            momentos = MomentosWelford();
+            for (size_t i = 0; i < valores.size(); i++) {
+                suma.agregar(valores[i]);
+                momentos.agregar(valores[i], i + 1);
+            }
+            expulsionesDesdeRecalculo = 0;
+        }
+    }
+
+public:
+    explicit VentanaRetencion(PoliticaRetencion politica)
+        : politica(politica),
+          tiempos(politica.capacidad), valores(politica.capacidad),
+          colaMinimos(politica.capacidad), colaMaximos(politica.capacidad) {}
+
+    // O(1) amortizado - Agregar un punto y expulsar los que salen de la política
+    void agregar(int64_t tiempo, double valor) {
+        if (politica.capacidad == 0) return;
+        if (valores.lleno()) expulsar();
+        if (politica.ventanaSegundos > 0) {
+            while (!tiempos.empty() && tiempos.front() <= tiempo - politica.ventanaSegundos) expulsar();
+        }
+
+        uint64_t secuencia = primeraSecuencia + valores.size();
+        if (!tiempos.empty() && tiempo < tiempos.back()) desordenes++;
+        tiempos.push_back(tiempo);
+        valores.push_back(valor);
+        suma.agregar(valor);
+        momentos.agregar(valor, valores.size());
+
+        // Ante empates se conserva el más antiguo (primera aparición)
+        while (!colaMinimos.empty() && valorDeSecuencia(colaMinimos.back()) > valor) colaMinimos.pop_back();
+        colaMinimos.push_back(secuencia);
+        while (!colaMaximos.empty() && valorDeSecuencia(colaMaximos.back()) < valor) colaMaximos.pop_back();
+        colaMaximos.push_back(secuencia);
+    }
+
+    // O(1) - Agregados de la ventana actual (índices relativos a la ventana)
+    Agregados getAgregados() const {
+        Agregados a;
+        a.n = valores.size();
+        if (a.n == 0) return a;
+        a.indiceMinimo = static_cast<size_t>(colaMinimos.front() - primeraSecuencia);
+        a.indiceMaximo = static_cast<size_t>(colaMaximos.front() - primeraSecuencia);
+        a.minimo = valores[a.indiceMinimo];
+        a.maximo = valores[a.indiceMaximo];
+        a.suma = suma;
+        a.momentos = momentos;
+        return a;
+    }
+
+    // O(log c + puntos del rango) ordenada, O(c) si no - Agregados de los puntos
+    // retenidos con tiempo en [t0, t1) (índices relativos a la ventana)
+    Agregados agregadosEnRango(int64_t t0, int64_t t1) const {
+        Agregados a;
+        if (t0 >= t1) return a;
+        if (estaOrdenada()) {
+            valores.recorrerTramos(primeraNoMenor(t0), primeraNoMenor(t1), [&](const double* datos, size_t k, size_t i) {
+                for (size_t j = 0; j < k; j++) a.agregar(datos[j], i + j);
+            });
+            return a;
+        }
+        for (size_t i = 0; i < valores.size(); i++) {
+            if (tiempos[i] >= t0 && tiempos[i] < t1) a.agregar(valores[i], i);
+        }
+        return a;
+    }
+
+    // O(log c) - Primera posición con tiempo >= t (size() si no hay).
+    // Precondición: estaOrdenada()
+    size_t primeraNoMenor(int64_t t) const {
+        size_t lo = 0, hi = tiempos.size();
+        while (lo < hi) {
+            size_t medio = lo + (hi - lo) / 2;
+            if (tiempos[medio] < t) lo = medio + 1;
+            else hi = medio;
+        }
+        return lo;
+    }
+
+    double valor(size_t i) const { return valores[i]; }          // O(1)
+    int64_t tiempo(size_t i) const { return tiempos[i]; }        // O(1)
+    size_t size() const { return valores.size(); }              // O(1)
+    bool estaOrdenada() const { return desordenes == 0; }        // O(1) - ningún tiempo retrocede
+    const BufferCircular<int64_t>& getTiempos() const { return tiempos; } // O(1)
+    const BufferCircular<double>& getValores() const { return valores; }  // O(1)
+    uint64_t getExpulsadas() const { return expulsadas; }        // O(1)
+    const PoliticaRetencion& getPolitica() const { return politica; } // O(1)
+};
+
+#endif
@@ -0,0 +1,154 @@
+/**
+ * MICROBENCHMARK: carga serial contra carga paralela del CSV
+ * Carga el mismo CSV sintético con cargarDesdeCSV, cargarDesdeCSVMapeado y
+ * cargarDesdeCSVParalelo con varios números de hilos, reporta los tiempos y
+ * comprueba que la carga paralela sea idéntica bit a bit a la serial: cada
+ * columna (tiempos y valores), los agregados (suma compensada y momentos
+ * incluidos), los niveles del bosquejo de cuantiles y los conteos del
+ * histograma. El archivo incluye filas mal formadas y termina sin '\n', para
+ * que los cortes entre hilos caigan también cerca de ellas.
+ *
+ * Compilación (desde la raíz del proyecto):
+ *   g++ -std=c++17 -O2 -pthread -I. benchmarks/bench_carga.cpp -o bench_carga
+ * Uso:
+ *   ./bench_carga [filas] [archivo]
+ */
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include "Sensores.h"
+
+// O(n) - Generar un CSV con el formato (y encabezado) de datos.csv; una de cada
+// 997 filas trae un valor no numérico y se descarta al cargar
+static void generarCSV(const std::string& nombre, size_t filas) {
+    std::ofstream out(nombre);
+    out << "Lectura,Fecha,Temperatura,Humedad\n";
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> temp(150, 350);  // 15.0 - 35.0 °C
+    std::uniform_int_distribution<int> hum(200, 950);   // 20.0 - 95.0 %
+    char linea[96];
+    for (size_t i = 0; i < filas; i++) {
+        long s = static_cast<long>(i % 86400);
+        int t = temp(rng), h = hum(rng);
+        int n = (i % 997 == 500)
+            ? std::snprintf(linea, sizeof(linea), "%zu,2025-09-25 %02ld:%02ld:%02ld,N/A,%d.%d\n",
+                            i + 1, s / 3600, (s / 60) % 60, s % 60, h / 10, h % 10)
+            : std::snprintf(linea, sizeof(linea), "%zu,2025-09-25 %02ld:%02ld:%02ld,%d.%d,%d.%d\n",
+                            i + 1, s / 3600, (s / 60) % 60, s % 60, t / 10, t % 10, h / 10, h % 10);
+        out.write(linea, i + 1 == filas ? n - 1 : n);
+    }
+}
+
+// O(1) - Los sensores de datos.csv, con histograma para comparar también sus conteos
+static std::unique_ptr<SistemaSensores> crearSistema() {
+    auto sistema = std::make_unique<SistemaSensores>();
+    sistema->agregarSensor(std::make_unique<SensorTemperatura>("TEMP_001"));
+    auto humedad = std::make_unique<SensorHumedad>("HUM_001");
+    humedad->activarDistribucionConfort();
+    sistema->agregarSensor(std::move(humedad));
+    return sistema;
+}
+
+// O(1) - Igualdad bit a bit (distingue -0.0 de 0.0 y compara NaN por su patrón)
+static bool mismosBits(double a, double b) { return std::memcmp(&a, &b, sizeof(double)) == 0; }
+
+static bool mismosAgregados(const Agregados& a, const Agregados& b) {
+    return a.n == b.n && a.indiceMinimo == b.indiceMinimo && a.indiceMaximo == b.indiceMaximo
+        && mismosBits(a.minimo, b.minimo) && mismosBits(a.maximo, b.maximo)
+        && mismosBits(a.suma.suma, b.suma.suma) && mismosBits(a.suma.compensacion, b.suma.compensacion)
+        && mismosBits(a.momentos.media, b.momentos.media) && mismosBits(a.momentos.m2, b.momentos.m2);
+}
+
+static bool mismoBosquejo(const BosquejoKLL& a, const BosquejoKLL& b) {
+    if (a.size() != b.size() || a.numNiveles() != b.numNiveles()
+        || a.getEstadoAleatorio() != b.getEstadoAleatorio()
+        || !mismosBits(a.getMinimo(), b.getMinimo()) || !mismosBits(a.getMaximo(), b.getMaximo())) return false;
+    for (size_t h = 0; h < a.numNiveles(); h++) {
+        const auto& na = a.getNivel(h);
+        const auto& nb = b.getNivel(h);
+        if (na.size() != nb.size() || std::memcmp(na.data(), nb.data(), na.size() * sizeof(double)) != 0) return false;
+    }
+    return true;
+}
+
+static bool mismoHistograma(const Histograma* a, const Histograma* b) {
+    if (!a || !b) return a == b;
+    if (a->numCubetas() != b->numCubetas() || a->getTotal() != b->getTotal()) return false;
+    for (size_t c = 0; c < a->numCubetas(); c++) {
+        if (a->conteo(c) != b->conteo(c)) return false;
+    }
+    return true;
+}
+
+// O(n) - Comparar sensor por sensor; reporta el primer sensor que difiere
+static bool identicos(SistemaSensores& a, SistemaSensores& b) {
+    for (const char* id : {"TEMP_001", "HUM_001"}) {
+        const Sensor* sa = a.buscarSensor(id);
+        const Sensor* sb = b.buscarSensor(id);
+        bool iguales = sa && sb && sa->getNumLecturas() == sb->getNumLecturas()
+            && mismosAgregados(sa->getAgregados(), sb->getAgregados())
+            && mismoBosquejo(sa->getBosquejoCuantiles(), sb->getBosquejoCuantiles())
+            && mismoHistograma(sa->getHistograma(), sb->getHistograma());
+        for (size_t i = 0; iguales && i < sa->getNumLecturas(); i++) {
+            iguales = sa->getTiempo(i) == sb->getTiempo(i) && mismosBits(sa->getValor(i), sb->getValor(i));
+        }
+        if (!iguales) {
+            std::cout << "  difiere en " << id << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+using Reloj = std::chrono::steady_clock;
+
+static double msDesde(Reloj::time_point inicio) {
+    return std::chrono::duration<double, std::milli>(Reloj::now() - inicio).count();
+}
+
+int main(int argc, char** argv) {
+    size_t filas = argc > 1 ? std::stoul(argv[1]) : 3000000;
+    std::string nombre = argc > 2 ? argv[2] : "datos_sintetico.csv";
+
+    std::cout << "Generando " << filas << " filas en " << nombre << "..." << std::endl;
+    generarCSV(nombre, filas);
+
+    // Referencia: el cargador mapeado serial (también se verifica el de ifstream)
+    auto referencia = crearSistema();
+    auto inicio = Reloj::now();
+    bool ok = referencia->cargarDesdeCSVMapeado(nombre);
+    double msSerial = msDesde(inicio);
+
+    auto conStream = crearSistema();
+    inicio = Reloj::now();
+    ok = conStream->cargarDesdeCSV(nombre) && ok;
+    double msStream = msDesde(inicio);
+    bool iguales = ok && identicos(*referencia, *conStream);
+
+    std::cout << "Lecturas:            " << referencia->buscarSensor("TEMP_001")->getNumLecturas()
+              << " + " << referencia->buscarSensor("HUM_001")->getNumLecturas() << std::endl;
+    std::cout << "cargarDesdeCSV:      " << msStream << " ms" << (iguales ? "" : " (DIFIERE)") << std::endl;
+    std::cout << "Mapeado serial:      " << msSerial << " ms" << std::endl;
+
+    unsigned nucleos = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned hilos : {1u, 2u, 3u, 4u, 8u, 16u, nucleos}) {
+        auto paralelo = crearSistema();
+        inicio = Reloj::now();
+        bool cargado = paralelo->cargarDesdeCSVParalelo(nombre, hilos);
+        double ms = msDesde(inicio);
+        bool igual = cargado && identicos(*referencia, *paralelo);
+        iguales = iguales && igual;
+        std::cout << "Paralelo, " << hilos << (hilos < 10 ? " hilos:  " : " hilos: ") << ms
+                  << " ms (x" << msSerial / ms << ")" << (igual ? "" : " (DIFIERE)") << std::endl;
+    }
+    std::cout << "Idéntico bit a bit al serial: " << (iguales ? "sí" : "NO") << std::endl;
+
+    std::remove(nombre.c_str());
+    return iguales ? 0 : 1;
+}
@@ -0,0 +1,84 @@
+/**
+ * MICROBENCHMARK: parseo de Temperatura/Humedad
+ * Compara std::stod(line.substr(...)) (ruta original de cargarDesdeCSV)
+ * contra parsearDouble sobre un datos.csv sintético de 10M filas.
+ *
+ * Compilación (desde la raíz del proyecto):
+ *   g++ -std=c++17 -O2 -I. benchmarks/bench_parseo.cpp -o bench_parseo
+ * Uso:
+ *   ./bench_parseo [filas] [archivo]
+ */
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "ArchivoMapeado.h"
+#include "ParseoCSV.h"
+
+// O(n) - Generar un CSV con el mismo formato que datos.csv
+static void generarCSV(const std::string& nombre, size_t filas) {
+    std::ofstream out(nombre);
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> temp(150, 350);  // 15.0 - 35.0 °C
+    std::uniform_int_distribution<int> hum(200, 950);   // 20.0 - 95.0 %
+    char linea[96];
+    for (size_t i = 0; i < filas; i++) {
+        long s = static_cast<long>(i % 86400);
+        int t = temp(rng), h = hum(rng);
+        int n = std::snprintf(linea, sizeof(linea), "%zu,2025-09-25 %02ld:%02ld:%02ld,%d.%d,%d.%d\n",
+                              i + 1, s / 3600, (s / 60) % 60, s % 60, t / 10, t % 10, h / 10, h % 10);
+        out.write(linea, n);
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t filas = argc > 1 ? std::stoul(argv[1]) : 10000000;
+    std::string nombre = argc > 2 ? argv[2] : "datos_sintetico.csv";
+
+    std::cout << "Generando " << filas << " filas en " << nombre << "..." << std::endl;
+    generarCSV(nombre, filas);
+
+    ArchivoMapeado archivo(nombre);
+    if (!archivo.valido()) {
+        std::cerr << "Error: no se pudo mapear " << nombre << std::endl;
+        return 1;
+    }
+
+    // O(l) - Separar los campos una sola vez para medir solo el parseo
+    std::vector<std::string_view> campos;
+    campos.reserve(filas * 2);
+    recorrerFilas(archivo.contenido(), [&](const std::vector<std::string_view>& fila) {
+        if (fila.size() < 4) return;
+        campos.push_back(fila[2]); // Temperatura
+        campos.push_back(fila[3]); // Humedad
+    });
+
+    using Reloj = std::chrono::steady_clock;
+    std::vector<double> conStod(campos.size()), conParseo(campos.size());
+
+    auto t0 = Reloj::now();
+    for (size_t i = 0; i < campos.size(); i++) {
+        conStod[i] = std::stod(std::string(campos[i])); // Ruta original: substr + stod
+    }
+    auto t1 = Reloj::now();
+    size_t rechazados = 0;
+    for (size_t i = 0; i < campos.size(); i++) {
+        rechazados += !parsearDouble(campos[i], conParseo[i]);
+    }
+    auto t2 = Reloj::now();
+
+    double msStod = std::chrono::duration<double, std::milli>(t1 - t0).count();
+    double msParseo = std::chrono::duration<double, std::milli>(t2 - t1).count();
+    bool iguales = rechazados == 0 && conStod == conParseo;
+
+    std::cout << "Valores parseados: " << campos.size() << std::endl;
+    std::cout << "std::stod:      " << msStod << " ms" << std::endl;
+    std::cout << "parsearDouble:  " << msParseo << " ms (x" << msStod / msParseo << ")" << std::endl;
+    std::cout << "Resultados idénticos: " << (iguales ? "sí" : "NO") << std::endl;
+
+    std::remove(nombre.c_str());
+    return iguales ? 0 : 1;
+}
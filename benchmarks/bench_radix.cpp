@@ -0,0 +1,67 @@
+/**
+ * MICROBENCHMARK: ordenamiento de lecturas (valor, índice)
+ * Compara std::sort sobre pair<double, uint32_t> contra ordenarRadix y
+ * ordenarRadixParalelo sobre lecturas sintéticas de temperatura (10M por defecto;
+ * 100M requiere ~8 GB de memoria).
+ *
+ * Compilación (desde la raíz del proyecto):
+ *   g++ -std=c++17 -O2 -pthread -I. benchmarks/bench_radix.cpp -o bench_radix
+ * Uso:
+ *   ./bench_radix [lecturas] [hilos]
+ */
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+#include <algorithm>
+#include "OrdenamientoRadix.h"
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? std::stoul(argv[1]) : 10000000;
+    unsigned hilos = argc > 2 ? static_cast<unsigned>(std::stoul(argv[2])) : 0;
+
+    // O(n) - Temperaturas con una décima, como las del CSV (-10.0 a 45.0 °C)
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> decimas(-100, 450);
+    std::vector<ParValorIndice> base(n);
+    for (size_t i = 0; i < n; i++) base[i] = {decimas(rng) / 10.0, static_cast<uint32_t>(i)};
+
+    using Reloj = std::chrono::steady_clock;
+    std::vector<std::pair<double, uint32_t>> conSort(n);
+    for (size_t i = 0; i < n; i++) conSort[i] = {base[i].valor, base[i].indice};
+    auto t0 = Reloj::now();
+    std::sort(conSort.begin(), conSort.end()); // (valor, índice): mismo orden que un radix estable
+    auto t1 = Reloj::now();
+
+    std::vector<ParValorIndice> conRadix = base;
+    auto t2 = Reloj::now();
+    ordenarRadix(conRadix.data(), n);
+    auto t3 = Reloj::now();
+
+    std::vector<ParValorIndice> conParalelo = base;
+    auto t4 = Reloj::now();
+    ordenarRadixParalelo(conParalelo.data(), n, hilos);
+    auto t5 = Reloj::now();
+
+    bool iguales = true;
+    for (size_t i = 0; i < n && iguales; i++) {
+        iguales = conRadix[i].valor == conSort[i].first && conRadix[i].indice == conSort[i].second &&
+                  conParalelo[i].valor == conSort[i].first && conParalelo[i].indice == conSort[i].second;
+    }
+
+    double msSort = std::chrono::duration<double, std::milli>(t1 - t0).count();
+    double msRadix = std::chrono::duration<double, std::milli>(t3 - t2).count();
+    double msParalelo = std::chrono::duration<double, std::milli>(t5 - t4).count();
+    unsigned hilosUsados = hilos ? hilos : std::max(1u, std::thread::hardware_concurrency());
+
+    std::cout << "Lecturas ordenadas: " << n << std::endl;
+    std::cout << "std::sort:             " << msSort << " ms" << std::endl;
+    std::cout << "ordenarRadix:          " << msRadix << " ms (x" << msSort / msRadix << ")" << std::endl;
+    std::cout << "ordenarRadixParalelo:  " << msParalelo << " ms (x" << msSort / msParalelo
+              << ", " << hilosUsados << " hilos)" << std::endl;
+    std::cout << "Resultados idénticos: " << (iguales ? "sí" : "NO") << std::endl;
+    return iguales ? 0 : 1;
+}
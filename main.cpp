@@ -5,6 +5,8 @@
 #include <algorithm>
 #include <iomanip>
 #include <memory>
+#include <filesystem>
+#include <cstdlib>
 #include "matplotlibcpp.h"
 #include "Sensores.h"
 
@@ -15,7 +17,8 @@ namespace plt = matplotlibcpp;
  * PROPÓSITO: Encuentra los valores mínimos y máximos en un conjunto de datos
  * COMPLEJIDAD: O(n) donde n = tamaño del vector datos
  * 
- * std::min_element y std::max_element tienen complejidad O(n) cada uno
+ * calcularEstadisticas obtiene mínimo y máximo (con sus índices) en una sola
+ * pasada vectorizada, en lugar de std::min_element + std::max_element
  */
 void encontrarMinMax(const std::vector<double>& datos, 
                     const std::vector<std::string>& horas,
@@ -23,16 +26,12 @@ void encontrarMinMax(const std::vector<double>& datos,
                     std::string& minHora, std::string& maxHora) {
     if (datos.empty()) return;
     
-    auto minIt = std::min_element(datos.begin(), datos.end());  // O(n)
-    auto maxIt = std::max_element(datos.begin(), datos.end());  // O(n)
+    ResumenEstadistico r = calcularEstadisticas(datos.data(), datos.size());  // O(n)
     
-    size_t minIndex = std::distance(datos.begin(), minIt);  // O(1)
-    size_t maxIndex = std::distance(datos.begin(), maxIt);  // O(1)
-    
-    minVal = *minIt;
-    maxVal = *maxIt;
-    minHora = horas[minIndex];  // O(1)
-    maxHora = horas[maxIndex];  // O(1)
+    minVal = r.minimo;
+    maxVal = r.maximo;
+    minHora = horas[r.indiceMinimo];  // O(1)
+    maxHora = horas[r.indiceMaximo];  // O(1)
 }
 
 /**
@@ -52,19 +51,24 @@ void graficarPorHora(SistemaSensores& sistema) {
         return;
     }
     
-    const auto& temps = sensorTemp->getLecturas();  // O(1)
-    const auto& hums = sensorHum->getLecturas();    // O(1)
-    const auto& timestamps = sensorTemp->getTimestamps();  // O(1)
+    // O(n) - Copia contigua: matplotlibcpp solo grafica std::vector. Se recorre
+    // cada serie por tramos (si está comprimida, sin dejar una copia en el sensor)
+    std::vector<double> temps, hums;
+    auto copiarEn = [](std::vector<double>& destino) {
+        return [&destino](const double* datos, size_t k, size_t) { destino.insert(destino.end(), datos, datos + k); };
+    };
+    sensorTemp->recorrerLecturas(0, sensorTemp->getNumLecturas(), copiarEn(temps));
+    sensorHum->recorrerLecturas(0, sensorHum->getNumLecturas(), copiarEn(hums));
     
     // O(n) - Crear vector de índices
     std::vector<int> x(temps.size());
     for (size_t i = 0; i < x.size(); i++) x[i] = i+1;  // O(n)
 
-    // O(n) - Extraer horas de los timestamps
+    // O(n) - Formatear horas de los timestamps (solo para las etiquetas)
     std::vector<std::string> horas;
-    for (const auto& timestamp : timestamps) {  // O(n)
-        horas.push_back(timestamp.substr(11,5));  // O(1) por elemento
-    }
+    sensorTemp->recorrerTiempos(0, sensorTemp->getNumLecturas(), [&](const int64_t* tiempos, size_t k, size_t) {
+        for (size_t i = 0; i < k; i++) horas.push_back(formatearHora(tiempos[i]));  // O(1) por elemento
+    });
 
     // O(n) - Preparar etiquetas para eje X (con muestreo)
     std::vector<int> xticks;
@@ -94,9 +98,12 @@ void graficarPorHora(SistemaSensores& sistema) {
 /**
  * FUNCIÓN: graficarOrdenadas
  * PROPÓSITO: Genera gráficas de temperatura y humedad ordenadas por valor
- * COMPLEJIDAD: O(n log n) - Dominada por std::sort
+ * COMPLEJIDAD: O(n) con ordenamiento radix de una permutación temporal (O(n log n)
+ *              en el respaldo por comparación); O(n) si el sensor ya tiene índice de orden
  * 
- * La operación más costosa es el ordenamiento de los vectores
+ * No se copian pares (valor, hora): se recorre una permutación de posiciones que se
+ * descarta al terminar (la gráfica no activa índices en los sensores), y las horas
+ * solo se formatean para las etiquetas muestreadas
  */
 void graficarOrdenadas(SistemaSensores& sistema) {
     // O(1) - Acceso directo a sensores
@@ -108,41 +115,16 @@ void graficarOrdenadas(SistemaSensores& sistema) {
         return;
     }
     
-    const auto& temps = sensorTemp->getLecturas();  // O(1)
-    const auto& hums = sensorHum->getLecturas();    // O(1)
-    const auto& timestamps = sensorTemp->getTimestamps();  // O(1)
-    
-    // O(n) - Extraer horas
-    std::vector<std::string> horas;
-    for (const auto& timestamp : timestamps) {  // O(n)
-        horas.push_back(timestamp.substr(11,5));  // O(1)
-    }
-
-    // O(n) - Crear vectores de pares (valor, hora)
-    std::vector<std::pair<double, std::string>> tempsOrd;
-    std::vector<std::pair<double, std::string>> humsOrd;
-    
-    for (size_t i = 0; i < temps.size(); i++) {  // O(n)
-        tempsOrd.push_back({temps[i], horas[i]});
-    }
-    for (size_t i = 0; i < hums.size(); i++) {  // O(n)
-        humsOrd.push_back({hums[i], horas[i]});
-    }
-
-    // O(n log n) - OPERACIÓN MÁS COSTOSA: ordenamiento
-    std::sort(tempsOrd.begin(), tempsOrd.end());   // O(n log n)
-    std::sort(humsOrd.begin(), humsOrd.end());     // O(n log n)
-
-    // O(1) - Los métodos getMinimo/getMaximo son O(1) si se cachean
-    double tempMin = sensorTemp->getMinimo();      // O(1) o O(n) dependiendo de implementación
-    double tempMax = sensorTemp->getMaximo();      // O(1) o O(n)
-    double humMin = sensorHum->getMinimo();        // O(1) o O(n)
-    double humMax = sensorHum->getMaximo();        // O(1) o O(n)
+    // O(1) - Los métodos getMinimo/getMaximo devuelven valores cacheados
+    double tempMin = sensorTemp->getMinimo();      // O(1)
+    double tempMax = sensorTemp->getMaximo();      // O(1)
+    double humMin = sensorHum->getMinimo();        // O(1)
+    double humMax = sensorHum->getMaximo();        // O(1)
     
-    std::string tempMinHora = sensorTemp->getTimestampMinimo();  // O(1) o O(n)
-    std::string tempMaxHora = sensorTemp->getTimestampMaximo();  // O(1) o O(n)
-    std::string humMinHora = sensorHum->getTimestampMinimo();    // O(1) o O(n)
-    std::string humMaxHora = sensorHum->getTimestampMaximo();    // O(1) o O(n)
+    std::string tempMinHora = sensorTemp->getTimestampMinimo();  // O(1)
+    std::string tempMaxHora = sensorTemp->getTimestampMaximo();  // O(1)
+    std::string humMinHora = sensorHum->getTimestampMinimo();    // O(1)
+    std::string humMaxHora = sensorHum->getTimestampMaximo();    // O(1)
 
     // O(1) - Cálculos simples
     double tempRango = tempMax - tempMin;
@@ -153,21 +135,19 @@ void graficarOrdenadas(SistemaSensores& sistema) {
     plt::title("Temperaturas ordenadas (" + sensorTemp->getUnidad() + ")");
     
     // O(n) - Preparar datos para gráfica
+    // O(n) - Recorrer las lecturas en orden de valor (con su posición)
     std::vector<double> yT, xT;
-    std::vector<std::string> xtick_labels_T;
-    for (size_t i = 0; i < tempsOrd.size(); i++) {  // O(n)
-        xT.push_back(i+1);
-        yT.push_back(tempsOrd[i].first);
-        xtick_labels_T.push_back(tempsOrd[i].second);
-    }
+    std::vector<size_t> posicionesT;
+    sensorTemp->recorrerEnOrden([&](double valor, size_t posicion) {
+        xT.push_back(xT.size() + 1);
+        yT.push_back(valor);
+        posicionesT.push_back(posicion);
+    });
     plt::plot(xT, yT, "r-");  // O(n)
 
-    // O(n) - Buscar posiciones de mínimos/máximos en vector ordenado
-    auto minTempIt = std::find(yT.begin(), yT.end(), tempMin);  // O(n)
-    auto maxTempIt = std::find(yT.begin(), yT.end(), tempMax);  // O(n)
-    
-    if (minTempIt != yT.end()) {
-        size_t minIndex = std::distance(yT.begin(), minTempIt);  // O(1)
+    // O(log n) - El rango de un valor es su primera aparición en el orden (bisección sobre yT)
+    if (!yT.empty()) {
+        size_t minIndex = std::lower_bound(yT.begin(), yT.end(), tempMin) - yT.begin();  // O(log n)
         plt::plot(std::vector<double>{xT[minIndex]}, std::vector<double>{tempMin}, "go");  // O(1)
         
         std::stringstream ss;
@@ -175,8 +155,8 @@ void graficarOrdenadas(SistemaSensores& sistema) {
         plt::text(xT[minIndex], tempMin + tempRango * 0.08, ss.str());  // O(1)
     }
     
-    if (maxTempIt != yT.end()) {
-        size_t maxIndex = std::distance(yT.begin(), maxTempIt);  // O(1)
+    if (!yT.empty()) {
+        size_t maxIndex = std::lower_bound(yT.begin(), yT.end(), tempMax) - yT.begin();  // O(log n)
         plt::plot(std::vector<double>{xT[maxIndex]}, std::vector<double>{tempMax}, "ro");  // O(1)
         
         std::stringstream ss;
@@ -190,7 +170,7 @@ void graficarOrdenadas(SistemaSensores& sistema) {
     int stepT = std::max(1, (int)xT.size()/8);  // O(1)
     for (size_t i = 0; i < xT.size(); i += stepT) {  // O(n/step) = O(n)
         xticksT.push_back(xT[i]);
-        xticksLabelT.push_back(xtick_labels_T[i]);
+        xticksLabelT.push_back(formatearHora(sensorTemp->getTiempo(posicionesT[i])));
     }
     plt::xticks(xticksT, xticksLabelT);
 
@@ -198,24 +178,21 @@ void graficarOrdenadas(SistemaSensores& sistema) {
     double tempMargin = tempRango * 0.15;
     plt::ylim(tempMin - tempMargin, tempMax + tempMargin);
 
-    // --- Graficar humedades ordenadas (complejidad similar: O(n log n + n)) ---
+    // --- Graficar humedades ordenadas (complejidad similar: O(n)) ---
     plt::subplot(2,1,2);
     plt::title("Humedades ordenadas (%)");
     
     std::vector<double> yH, xH;
-    std::vector<std::string> xtick_labels_H;
-    for (size_t i = 0; i < humsOrd.size(); i++) {  // O(n)
-        xH.push_back(i+1);
-        yH.push_back(humsOrd[i].first);
-        xtick_labels_H.push_back(humsOrd[i].second);
-    }
+    std::vector<size_t> posicionesH;
+    sensorHum->recorrerEnOrden([&](double valor, size_t posicion) {
+        xH.push_back(xH.size() + 1);
+        yH.push_back(valor);
+        posicionesH.push_back(posicion);
+    });
     plt::plot(xH, yH, "b-");  // O(n)
 
-    auto minHumIt = std::find(yH.begin(), yH.end(), humMin);  // O(n)
-    auto maxHumIt = std::find(yH.begin(), yH.end(), humMax);  // O(n)
-    
-    if (minHumIt != yH.end()) {
-        size_t minIndex = std::distance(yH.begin(), minHumIt);  // O(1)
+    if (!yH.empty()) {
+        size_t minIndex = std::lower_bound(yH.begin(), yH.end(), humMin) - yH.begin();  // O(log n)
         plt::plot(std::vector<double>{xH[minIndex]}, std::vector<double>{humMin}, "go");  // O(1)
         
         std::stringstream ss;
@@ -223,8 +200,8 @@ void graficarOrdenadas(SistemaSensores& sistema) {
         plt::text(xH[minIndex], humMin + humRango * 0.08, ss.str());  // O(1)
     }
     
-    if (maxHumIt != yH.end()) {
-        size_t maxIndex = std::distance(yH.begin(), maxHumIt);  // O(1)
+    if (!yH.empty()) {
+        size_t maxIndex = std::lower_bound(yH.begin(), yH.end(), humMax) - yH.begin();  // O(log n)
         plt::plot(std::vector<double>{xH[maxIndex]}, std::vector<double>{humMax}, "ro");  // O(1)
         
         std::stringstream ss;
@@ -238,7 +215,7 @@ void graficarOrdenadas(SistemaSensores& sistema) {
     int stepH = std::max(1, (int)xH.size()/8);  // O(1)
     for (size_t i = 0; i < xH.size(); i += stepH) {  // O(n/step) = O(n)
         xticksH.push_back(xH[i]);
-        xticksLabelH.push_back(xtick_labels_H[i]);
+        xticksLabelH.push_back(formatearHora(sensorHum->getTiempo(posicionesH[i])));
     }
     plt::xticks(xticksH, xticksLabelH);
 
@@ -249,28 +226,32 @@ void graficarOrdenadas(SistemaSensores& sistema) {
     plt::tight_layout();
     plt::show();
 
-    // O(1) - Salida a consola (mostrarResumen es O(1) si los valores están cacheados)
+    // O(1) - Salida a consola (mostrarResumen usa valores cacheados)
     std::cout << "\n=== RESUMEN DE VALORES EXTREMOS ===" << std::endl;
-    sensorTemp->mostrarResumen();  // O(1) o O(n)
+    sensorTemp->mostrarResumen();  // O(1)
     std::cout << std::endl;
-    sensorHum->mostrarResumen();   // O(1) o O(n)
+    sensorHum->mostrarResumen();   // O(1)
     
     std::cout << "\n=== INFORMACIÓN ADICIONAL ===" << std::endl;
-    if (sensorTemp->tieneFiebre()) {  // O(1) o O(n)
+    if (sensorTemp->tieneFiebre()) {  // O(1)
         std::cout << "Alerta: Se detectaron temperaturas de fiebre (>38°C)" << std::endl;
     } else {
         std::cout << "Temperaturas dentro del rango normal" << std::endl;
     }
     
-    std::cout << "Nivel de confort por humedad: " << sensorHum->getNivelConfort() << std::endl;  // O(1) o O(n)
+    std::cout << "Nivel de confort por humedad: " << sensorHum->getNivelConfort() << std::endl;  // O(1)
 }
 
 /**
  * FUNCIÓN: buscarTemperaturaPorHora
- * PROPÓSITO: Permite buscar la temperatura para una hora específica usando búsqueda binaria
- * COMPLEJIDAD: O(n log n) - Dominada por el ordenamiento inicial
+ * PROPÓSITO: Permite buscar la temperatura para una hora específica usando el
+ *            índice temporal del sensor
+ * COMPLEJIDAD: O(n log n) para listar las horas ordenadas; la búsqueda es O(d log n),
+ *              d = días con datos
  * 
- * La búsqueda binaria es O(log n) pero requiere datos ordenados O(n log n)
+ * El índice se mantiene al agregar lecturas: la búsqueda no copia ni ordena.
+ * Si no hay lectura en ese minuto se muestran, del día cuya lectura queda más
+ * cerca de esa hora, la lectura más cercana y el valor interpolado.
  */
 void buscarTemperaturaPorHora(SistemaSensores& sistema) {
     // O(1) - Acceso directo al sensor
@@ -280,31 +261,22 @@ void buscarTemperaturaPorHora(SistemaSensores& sistema) {
         return;
     }
     
-    const auto& lecturas = sensorTemp->getLecturas();      // O(1)
-    const auto& timestamps = sensorTemp->getTimestamps();  // O(1)
-    
-    // O(n) - Preparar vector de pares (hora, temperatura)
-    std::vector<std::pair<std::string, double>> horaTemp;
-    for (size_t i = 0; i < timestamps.size(); i++) {  // O(n)
-        std::string hora = timestamps[i].substr(11, 5);  // O(1)
-        horaTemp.push_back({hora, lecturas[i]});         // O(1)
-    }
-    
-    // O(n log n) - Ordenar por hora para habilitar búsqueda binaria
-    std::sort(horaTemp.begin(), horaTemp.end(),  // O(n log n)
-              [](const auto& a, const auto& b) {
-                  return a.first < b.first;      // O(1) por comparación
-              });
-    
     std::cout << "\n=== BUSCAR TEMPERATURA POR HORA ===" << std::endl;
     std::cout << "Sensor: " << sensorTemp->getId() << " - " << sensorTemp->getTipo() << std::endl;
     std::cout << "Horas disponibles (formato HH:MM):" << std::endl;
     
-    // O(n) - Mostrar horas disponibles (con muestreo implícito de 3 en 3)
-    for (size_t i = 0; i < horaTemp.size(); i += 3) {  // O(n/3) = O(n)
-        std::cout << horaTemp[i].first;
-        if (i + 1 < horaTemp.size()) std::cout << ", " << horaTemp[i+1].first;  // O(1)
-        if (i + 2 < horaTemp.size()) std::cout << ", " << horaTemp[i+2].first;  // O(1)
+    // O(n log n) - Horas disponibles ordenadas y sin repetir (de 3 en 3)
+    std::vector<std::string> horas;
+    horas.reserve(sensorTemp->getNumLecturas());
+    sensorTemp->recorrerTiempos(0, sensorTemp->getNumLecturas(), [&](const int64_t* tiempos, size_t k, size_t) {
+        for (size_t i = 0; i < k; i++) horas.push_back(formatearHora(tiempos[i]));  // O(1) por hora
+    });
+    std::sort(horas.begin(), horas.end());  // O(n log n)
+    horas.erase(std::unique(horas.begin(), horas.end()), horas.end());
+    for (size_t i = 0; i < horas.size(); i += 3) {  // O(n/3) = O(n)
+        std::cout << horas[i];
+        if (i + 1 < horas.size()) std::cout << ", " << horas[i+1];  // O(1)
+        if (i + 2 < horas.size()) std::cout << ", " << horas[i+2];  // O(1)
         std::cout << std::endl;
     }
     
@@ -312,37 +284,91 @@ void buscarTemperaturaPorHora(SistemaSensores& sistema) {
     std::cout << "\nIngrese la hora a buscar (HH:MM): ";
     std::cin >> horaBuscada;
     
-    // O(1) - Validación de formato
-    if (horaBuscada.length() != 5 || horaBuscada[2] != ':') {
+    // O(1) - Validación de formato y conversión a segundos desde la medianoche
+    int64_t segundosBuscados;
+    if (horaBuscada.length() != 5 || horaBuscada[2] != ':' ||
+        !parsearFechaHora("1970-01-01 " + horaBuscada + ":00", segundosBuscados)) {
         std::cout << "Formato de hora inválido. Use HH:MM (ej: 14:30)" << std::endl;
         return;
     }
     
-    // O(log n) - BÚSQUEDA BINARIA (operación eficiente)
-    bool encontrada = std::binary_search(horaTemp.begin(), horaTemp.end(),  // O(log n)
-                                        std::make_pair(horaBuscada, 0.0),
-                                        [](const auto& a, const auto& b) {
-                                            return a.first < b.first;  // O(1)
-                                        });
-    
-    if (encontrada) {
-        // O(log n) - Encontrar posición exacta
-        auto it = std::lower_bound(horaTemp.begin(), horaTemp.end(),  // O(log n)
-                                  std::make_pair(horaBuscada, 0.0),
-                                  [](const auto& a, const auto& b) {
-                                      return a.first < b.first;  // O(1)
-                                  });
-        
-        if (it != horaTemp.end() && it->first == horaBuscada) {  // O(1)
-            std::cout << "✓ Temperatura a las " << horaBuscada << ": " 
-                      << std::fixed << std::setprecision(1) << it->second 
-                      << sensorTemp->getUnidad() << std::endl;
+    // O(d log n) - Para cada día con datos, buscar en el índice la primera lectura
+    // dentro de ese minuto [HH:MM:00, HH:MM:59]
+    size_t posicion = SIN_POSICION;
+    int64_t desde = 0, hasta = 0;
+    bool hayLecturas = sensorTemp->getRangoTiempos(desde, hasta);  // O(log n)
+    if (hayLecturas) {
+        for (int64_t dia = inicioDelDia(desde); dia <= hasta && posicion == SIN_POSICION; dia += 86400) {
+            int64_t inicio = dia + segundosBuscados;
+            posicion = sensorTemp->buscarPrimeroEnRango(inicio, inicio + 60);  // O(log n)
         }
+    }
+    
+    if (posicion != SIN_POSICION) {
+        std::cout << "✓ Temperatura a las " << horaBuscada << ": " 
+                  << std::fixed << std::setprecision(1) << sensorTemp->getValor(posicion)  // O(1)
+                  << sensorTemp->getUnidad() << std::endl;
     } else {
         std::cout << "✗ No se encontraron datos para la hora " << horaBuscada << std::endl;
+        if (!hayLecturas) return;
+        
+        // O(d log n) - Sin lectura en ese minuto: de todos los días con datos, el
+        // instante HH:MM con la lectura más cercana; se muestran esa lectura y el
+        // valor interpolado en ese instante, con la fecha usada
+        int64_t instante = 0, distancia = 0;
+        size_t cercana = SIN_POSICION;
+        for (int64_t dia = inicioDelDia(desde); dia <= hasta; dia += 86400) {
+            size_t candidata = sensorTemp->buscarMasCercano(dia + segundosBuscados);  // O(log n)
+            int64_t d = std::llabs(sensorTemp->getTiempo(candidata) - (dia + segundosBuscados));
+            if (cercana == SIN_POSICION || d < distancia) {
+                cercana = candidata;
+                distancia = d;
+                instante = dia + segundosBuscados;
+            }
+        }
+        std::cout << "  Día usado: " << formatearFechaHora(instante).substr(0, 10) << std::endl;
+        std::cout << "  Lectura más cercana: " << formatearHora(sensorTemp->getTiempo(cercana)) << " -> "
+                  << std::fixed << std::setprecision(1) << sensorTemp->getValor(cercana)
+                  << sensorTemp->getUnidad() << std::endl;
+        double interpolada;
+        if (sensorTemp->interpolarEn(instante, interpolada)) {
+            std::cout << "  Valor interpolado a las " << horaBuscada << ": "
+                      << interpolada << sensorTemp->getUnidad() << std::endl;
+        }
     }
 }
 
+/**
+ * FUNCIÓN: cargarDatos
+ * PROPÓSITO: Carga los sensores desde la instantánea binaria si está al día con
+ *            el CSV; si no, parsea el CSV y deja la instantánea para el próximo inicio.
+ *            En ese caso el WAL se descarta: sus lecturas eran relativas a la
+ *            instantánea anterior, que el CSV reemplaza
+ * COMPLEJIDAD: O(n) - Con instantánea no hay parseo: solo copia de columnas mapeadas
+ */
+bool cargarDatos(SistemaSensores& sistema, const std::string& archivoCSV,
+                 const std::string& archivoInstantanea, const std::string& archivoRegistro) {
+    namespace fs = std::filesystem;
+    std::error_code errorCSV, errorInstantanea;
+    auto fechaCSV = fs::last_write_time(archivoCSV, errorCSV);
+    auto fechaInstantanea = fs::last_write_time(archivoInstantanea, errorInstantanea);
+    
+    // O(n) - Instantánea igual o más reciente que el CSV (o sin CSV)
+    if (!errorInstantanea && (errorCSV || fechaInstantanea >= fechaCSV) &&
+        sistema.cargarInstantanea(archivoInstantanea)) {
+        return true;
+    }
+    
+    // O(n) - Cargar datos desde CSV (n = número de líneas), mapeado en memoria
+    if (!sistema.cargarDesdeCSVMapeado(archivoCSV)) return false;
+    if (!sistema.guardarInstantanea(archivoInstantanea)) {
+        std::cerr << "Aviso: no se pudo guardar " << archivoInstantanea << std::endl;
+    }
+    std::error_code errorRegistro;
+    fs::remove(archivoRegistro, errorRegistro);
+    return true;
+}
+
 /**
  * FUNCIÓN: main
  * PROPÓSITO: Función principal que coordina todo el sistema de sensores
@@ -357,13 +383,23 @@ int main() {
     sistema.agregarSensor(std::make_unique<SensorTemperatura>("TEMP_001", "°C"));
     sistema.agregarSensor(std::make_unique<SensorHumedad>("HUM_001"));
     
-    // O(n) - Cargar datos desde CSV (n = número de líneas)
-    if (!sistema.cargarDesdeCSV("datos.csv")) {
+    // O(n) - Cargar datos (instantánea binaria o, si está desactualizada, CSV)
+    if (!cargarDatos(sistema, "datos.csv", "datos.snap", "datos.wal")) {
         std::cerr << "Error: no se pudo abrir datos.csv\n";
         return 1;
     }
     
-    // O(1) - Mostrar resumen inicial (si los valores están cacheados)
+    // O(r) - Reproducir las lecturas anotadas en el WAL desde la última
+    // instantánea (r = entradas) y anotar desde aquí cada lectura nueva antes de
+    // aplicarla. O(n) - Punto de control: la instantánea absorbe lo reproducido
+    // y el WAL vuelve a empezar vacío, así no crece entre ejecuciones
+    if (!sistema.activarRegistro("datos.wal")) {
+        std::cerr << "Aviso: no se pudo abrir el registro datos.wal" << std::endl;
+    } else if (!sistema.puntoDeControl("datos.snap")) {
+        std::cerr << "Aviso: no se pudo recortar el registro datos.wal" << std::endl;
+    }
+    
+    // O(1) - Mostrar resumen inicial
     sistema.mostrarTodosLosSensores();
     
     // O(n) - Gráfica por hora (operación lineal)